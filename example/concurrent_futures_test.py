@@ -42,7 +42,7 @@ dc = dart_context (args.anaconda_home, args.certificates_directory)
 
 dc.start (args.worker_description_file)
 
-from concurrent.futures import ProcessPoolExecutor, as_completed
+from concurrent.futures import ThreadPoolExecutor, as_completed
 future_list = []
                
 parameter_list = [ 'x=1\ny=5'
@@ -56,7 +56,7 @@ parameter_list = [ 'x=1\ny=5'
 def wait (handle):
   return dc.results.collect (handle)
                            
-with ProcessPoolExecutor (max_workers=5) as executor:
+with ThreadPoolExecutor (max_workers=5) as executor:
   for s in parameter_list:
     handle = dc.async_run ("test", [{'location':'local_cluster', 'parameters': [s]}])
     future_list.append (executor.submit (wait, handle))
@@ -18,7 +18,7 @@ dc.start ('nodefile', 4)
 
 parameters = dc.prepare_parameters (sys.argv[1])
 
-list_results = dc.results.extract (dc.run ('count_words', parameters))
+list_results = dc.run ('count_words', parameters)
 dc.results.store (list_results, '/var/tmp')
 
 for result in list_results:
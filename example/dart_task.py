@@ -28,3 +28,7 @@ def test (params):
   result = x * y
   
   return dc.pack (result)
+
+def noop (params):
+
+  return b''
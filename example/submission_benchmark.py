@@ -0,0 +1,43 @@
+#This example measures the time needed for submitting and executing jobs
+#consisting of a large number of empty tasks, e.g. for checking that
+#the submission and the distribution of the tasks scale linearly with
+#the number of tasks. The number of tasks per job can be given as
+#arguments, by default jobs with 10^5 and 10^6 tasks are executed.
+#
+#No reference numbers are recorded for this benchmark: it needs a running
+#GPI-Space installation and has not been run yet, hence neither the
+#speedup of submitting the task chunks as individual tokens over a single
+#list token nor the linear scaling are verified so far.
+
+import os
+import sys
+import time
+
+sys.path.insert (0, os.environ['DART_HOME'] + '/lib')
+from dart import dart_context
+
+n_tasks_per_job = [int (n) for n in sys.argv[1:]] or [10**5, 10**6]
+
+dc = dart_context (sys.exec_prefix)
+
+dc.start ('nodefile', 4)
+
+for n_tasks in n_tasks_per_job:
+  parameters = [{'location' : 'local_cluster', 'parameters' : [''] * n_tasks}]
+
+  start = time.time()
+  handle = dc.async_run ('noop', parameters, chunksize = 100)
+  submitted = time.time()
+
+  n_results = 0
+  results = dc.results.pop_many (handle, n_tasks)
+  while results:
+    n_results += len (results)
+    results = dc.results.pop_many (handle, n_tasks)
+  finished = time.time()
+
+  print ('{0:>8} tasks: submission {1:.3f}s, execution {2:.3f}s, {3} results'.format
+           (n_tasks, submitted - start, finished - submitted, n_results)
+        )
+
+dc.stop()
@@ -6,54 +6,137 @@ void translate (std::exception const& e)
   PyErr_SetString (PyExc_RuntimeError, e.what());
 }
 
+PyObject* job_aborted_type (nullptr);
+
+//! \note the exception carries the results delivered by the call that
+//! raised it as attribute results
+void translate_job_aborted (dart::job_aborted const& e)
+{
+  boost::python::object exception
+    ( boost::python::handle<>
+        (PyObject_CallFunction (job_aborted_type, "s", e.what()))
+    );
+  exception.attr ("results") = e.results;
+
+  PyErr_SetObject (job_aborted_type, exception.ptr());
+}
+
 boost::python::list (drts_wrapper::*exec_0)
   ( std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
   ) = &drts_wrapper::run;
 
 boost::python::list (drts_wrapper::*exec_1)
   ( std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
   , std::string const& output_directory
   ) = &drts_wrapper::run;
 
 boost::python::list (drts_wrapper::*exec_2)
   ( std::string const& abs_path_to_module
   , std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
   ) = &drts_wrapper::run;
 
 boost::python::list (drts_wrapper::*exec_3)
   ( std::string const& abs_path_to_module
   , std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
+  , std::string const& output_directory
+  ) = &drts_wrapper::run;
+
+boost::python::list (drts_wrapper::*exec_4)
+  ( std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , boost::python::dict const& options
+  ) = &drts_wrapper::run;
+
+boost::python::list (drts_wrapper::*exec_5)
+  ( std::string const& method
+  , boost::python::object const& locations_and_parameters
   , std::string const& output_directory
+  , boost::python::dict const& options
+  ) = &drts_wrapper::run;
+
+boost::python::list (drts_wrapper::*exec_6)
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , boost::python::dict const& options
+  ) = &drts_wrapper::run;
+
+boost::python::list (drts_wrapper::*exec_7)
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , std::string const& output_directory
+  , boost::python::dict const& options
   ) = &drts_wrapper::run;
 
 gspc::job_id_t (drts_wrapper::*async_exec_0)
   ( std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
   ) = &drts_wrapper::async_run;
 
 gspc::job_id_t (drts_wrapper::*async_exec_1)
   ( std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
   , std::string const& output_directory
   ) = &drts_wrapper::async_run;
 
 gspc::job_id_t (drts_wrapper::*async_exec_2)
   ( std::string const& abs_path_to_module
   , std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
   ) = &drts_wrapper::async_run;
 
 gspc::job_id_t (drts_wrapper::*async_exec_3)
   ( std::string const& abs_path_to_module
   , std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
+  , std::string const& output_directory
+  ) = &drts_wrapper::async_run;
+
+gspc::job_id_t (drts_wrapper::*async_exec_4)
+  ( std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , boost::python::dict const& options
+  ) = &drts_wrapper::async_run;
+
+gspc::job_id_t (drts_wrapper::*async_exec_5)
+  ( std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , std::string const& output_directory
+  , boost::python::dict const& options
+  ) = &drts_wrapper::async_run;
+
+gspc::job_id_t (drts_wrapper::*async_exec_6)
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , boost::python::dict const& options
+  ) = &drts_wrapper::async_run;
+
+gspc::job_id_t (drts_wrapper::*async_exec_7)
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , boost::python::object const& locations_and_parameters
   , std::string const& output_directory
+  , boost::python::dict const& options
   ) = &drts_wrapper::async_run;
 
+gspc::job_id_t (drts_wrapper::*open_job_0)
+  ( std::string const& method
+  , boost::python::dict const& options
+  ) = &drts_wrapper::open_job;
+
+gspc::job_id_t (drts_wrapper::*open_job_1)
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , std::string const& output_directory
+  , boost::python::dict const& options
+  ) = &drts_wrapper::open_job;
+
 void (drts_wrapper::*start_runtime_0)() = &drts_wrapper::start_runtime;
 void (drts_wrapper::*start_runtime_1) (std::string const&) = &drts_wrapper::start_runtime;
 void (drts_wrapper::*start_runtime_2) (std::string const&, std::size_t) = &drts_wrapper::start_runtime;
@@ -72,6 +155,16 @@ void (drts_wrapper::*add_workers_2)
   , std::size_t shm_size
   ) = &drts_wrapper::add_workers;
 
+boost::python::list (drts_wrapper::*pop_results_0)
+  (gspc::job_id_t const&, unsigned long) = &drts_wrapper::pop_results;
+boost::python::list (drts_wrapper::*pop_results_1)
+  (gspc::job_id_t const&, unsigned long, double) = &drts_wrapper::pop_results;
+
+boost::python::list (drts_wrapper::*cancel_0)
+  (gspc::job_id_t const&) = &drts_wrapper::cancel;
+boost::python::list (drts_wrapper::*cancel_1)
+  (gspc::job_id_t const&, bool) = &drts_wrapper::cancel;
+
 boost::python::dict (drts_wrapper::*remove_workers_0)() = &drts_wrapper::remove_workers;
 boost::python::dict (drts_wrapper::*remove_workers_1)
   (boost::python::list const&) = &drts_wrapper::remove_workers;
@@ -81,6 +174,11 @@ BOOST_PYTHON_MODULE (DART)
   using namespace boost::python;
   register_exception_translator<std::exception>(&translate);
 
+  job_aborted_type = PyErr_NewException
+    ("DART.JobAborted", PyExc_RuntimeError, NULL);
+  scope().attr ("JobAborted") = handle<> (borrowed (job_aborted_type));
+  register_exception_translator<dart::job_aborted>(&translate_job_aborted);
+
   class_<drts_wrapper, boost::noncopyable>
     ("runtime"
     , init<std::string, boost::python::dict>()
@@ -91,20 +189,38 @@ BOOST_PYTHON_MODULE (DART)
     .def("add_workers", add_workers_0)
     .def("add_workers", add_workers_1)
     .def("add_workers", add_workers_2)
+    .def("add_host_local_workers", &drts_wrapper::add_host_local_workers)
     .def("remove_workers", remove_workers_0)
     .def("remove_workers", remove_workers_1)
     .def("run", exec_0)
     .def("run", exec_1)
     .def("run", exec_2)
     .def("run", exec_3)
+    .def("run", exec_4)
+    .def("run", exec_5)
+    .def("run", exec_6)
+    .def("run", exec_7)
     .def("async_run", async_exec_0)
     .def("async_run", async_exec_1)
     .def("async_run", async_exec_2)
     .def("async_run", async_exec_3)
+    .def("async_run", async_exec_4)
+    .def("async_run", async_exec_5)
+    .def("async_run", async_exec_6)
+    .def("async_run", async_exec_7)
+    .def("open_job", open_job_0)
+    .def("open_job", open_job_1)
+    .def("put_parameters", &drts_wrapper::put_parameters)
+    .def("close_job", &drts_wrapper::close_job)
+    .def("cancel", cancel_0)
+    .def("cancel", cancel_1)
     .def("collect_results", &drts_wrapper::collect_results)
     .def("get_number_of_remaining_tasks", &drts_wrapper::get_number_of_remaining_tasks)
     .def("get_total_number_of_tasks", &drts_wrapper::get_total_number_of_tasks)
+    .def("get_number_of_workers_with_capability", &drts_wrapper::get_number_of_workers_with_capability)
     .def("pop_result", &drts_wrapper::pop_result)
+    .def("pop_results", pop_results_0)
+    .def("pop_results", pop_results_1)
     .def("stop", &drts_wrapper::stop_runtime)
     .def("__exit__", &drts_wrapper::stop_runtime)
     ;
@@ -1,4 +1,5 @@
 #include <cpp/drts_interface.hpp>
+#include <cpp/python_gil.hpp>
 #include <utils/utils.hpp>
 
 #include <pnetc/type/task_result/op.hpp>
@@ -6,12 +7,16 @@
 #include <pnetc/type/config/op.hpp>
 #include <pnetc/type/location_and_parameters.hpp>
 #include <pnetc/type/location_and_parameters/op.hpp>
+#include <pnetc/type/task_chunk/op.hpp>
+#include <pnetc/type/task_result_chunk/op.hpp>
 
 #include <drts/client.hpp>
 #include <drts/virtual_memory.hpp>
 #include <drts/worker_description.hpp>
 
+#include <we/type/literal/control.hpp>
 #include <we/type/value/from_value.hpp>
+#include <we/type/value/peek.hpp>
 #include <we/type/value/show.hpp>
 #include <we/type/value/unwrap.hpp>
 #include <we/type/value/wrap.hpp>
@@ -35,11 +40,14 @@
 #include "boost/any.hpp"
 #include "boost/iostreams/stream.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstdio>
 #include <future>
+#include <atomic>
 #include <iostream>
+#include <limits>
 #include <sstream>
 #include <vector>
 #include <memory>
@@ -78,13 +86,28 @@ drts_wrapper::drts_wrapper
                  )
   , _drts (nullptr)
   , _python_home (python_home)
+  , _python_library
+      ( user_opt.has_key ("python_library")
+      ? std::string (boost::python::extract<std::string> (user_opt["python_library"]))
+      : std::string()
+      )
 {
  std::cout << dladdr2 (const_cast<char*>("drts_wrapper")).dli_fname << std::endl;
  std::cout << boost::filesystem::canonical (dladdr2 (const_cast<char*>("drts_wrapper")).dli_fname).parent_path().parent_path() << std::endl;
 }
 
+drts_wrapper::~drts_wrapper()
+{
+  stop_share_updates();
+}
+
 void drts_wrapper::start_runtime()
 {
+  dart::scoped_gil_release const release;
+
+  std::lock_guard<std::mutex> const lock (_client_mutex);
+
+  _client.reset();
 
   _drts = std::make_unique<gspc::scoped_runtime_system>
             ( _vm
@@ -114,30 +137,7 @@ void drts_wrapper::start_runtime
   add_workers (nodefile, num_workers, capabilities, 0);
 }
 
-namespace 
-{
-    [[maybe_unused]]
-    void
-    print_variable_map (boost::program_options::variables_map &vm)
-    {
-        for (const auto& it : vm) 
-        {
-            std::cout << it.first.c_str() << " ";
-            auto& value = it.second.value();
-            if (auto v = boost::any_cast<uint32_t> (&value))
-                std::cout << "\t" << *v << std::endl;
-            else if (auto v = boost::any_cast<std::string> (&value))
-                std::cout << "\t" << *v << std::endl;
-            else if (auto v = boost::any_cast<std::vector<std::string>> (&value))
-            for (auto s : *v)
-                std::cout << "\t" << s << std::endl;
-            else
-                std::cout << "\t" << "error" << std::endl;
-        }
-    }
-}
-
-descriptions_and_entry_points_t drts_wrapper::parse_worker_description_file
+std::vector<dart::worker_group> drts_wrapper::parse_worker_description_file
   (boost::filesystem::path const& nodefile)
 {
   boost::property_tree::ptree pt;
@@ -145,7 +145,7 @@ descriptions_and_entry_points_t drts_wrapper::parse_worker_description_file
   boost::property_tree::json_parser::read_json
     (boost::filesystem::canonical (nodefile).string(), pt);
 
-  descriptions_and_entry_points_t descriptions_and_entry_points;
+  std::vector<dart::worker_group> worker_groups;
 
   for (boost::property_tree::ptree::value_type const& e : pt.get_child(""))
   {
@@ -170,7 +170,6 @@ descriptions_and_entry_points_t drts_wrapper::parse_worker_description_file
     std::vector<std::string> new_paras;
     for (const auto& it : _vm) 
     {
-        std::cout << it.first.c_str() << " ";
         if (it.first == "rif-strategy-parameters")
         { 
             auto& value = it.second.value();
@@ -200,44 +199,150 @@ descriptions_and_entry_points_t drts_wrapper::parse_worker_description_file
                   (std::string {"ssh"}, false)
                );
 
-
-    _worker_rifds.emplace_back
-      (new gspc::scoped_rifds ( gspc::rifd::strategy (vm) // here we need the ssh port
-                              , gspc::rifd::hostnames (hosts)
-                              , gspc::rifd::port (_vm) // here we need the rifd port
-                              , _gspc_installation
-                              )
+    worker_groups.push_back
+      ( { gspc::worker_description
+            { capabilities
+            , num_per_node
+            , 0
+            , shm_size
+            , boost::none
+            , boost::none
+            }
+        , hosts
+        , vm // here we need the ssh port
+        }
       );
+  }
+
+  return worker_groups;
+}
 
-    gspc::worker_description const description
-      { capabilities
-      , num_per_node
-      , 0
-      , shm_size
-      , boost::none
-      , boost::none
-      };
-
-    descriptions_and_entry_points.emplace_front
-      ( std::make_pair ( description
-                       , (*_worker_rifds.rbegin())->entry_points()
-                       )
+//! \note the rifds of the groups are bootstrapped concurrently, such
+//! that the bootstrap time is the one of the slowest group rather than
+//! the sum over all groups. The workers of a group are started as soon
+//! as its rifds are up, one group at a time. The report is printed also
+//! when a group failed, for the groups that did start.
+void drts_wrapper::add_workers
+  (std::vector<dart::worker_group> const& worker_groups)
+{
+  dart::scoped_gil_release const release;
+
+  std::vector<std::future<dart::worker_group_startup>> startups;
+
+  for (auto const& worker_group : worker_groups)
+  {
+    startups.emplace_back
+      ( std::async ( std::launch::async
+                   , [this, &worker_group]
+                     {
+                       return start_worker_group (worker_group);
+                     }
+                   )
       );
   }
 
-  return descriptions_and_entry_points;
+  std::exception_ptr error;
+  boost::format const line ("%1$6d hosts %2$-30s rifd bootstrap %3$8.3fs, worker start %4$8.3fs\n");
+  boost::format const failed_line ("%1$6d hosts %2$-30s failed: %3%\n");
+
+  std::ostringstream report;
+  report << "Startup of " << worker_groups.size() << " worker group(s):\n";
+
+  for (std::size_t i (0); i < startups.size(); ++i)
+  {
+    try
+    {
+      dart::worker_group_startup const startup (startups[i].get());
+
+      report << boost::format (line)
+                % worker_groups[i].hosts.size()
+                % boost::algorithm::join
+                    (worker_groups[i].description.capabilities, ",")
+                % startup.bootstrap.count()
+                % startup.worker_start.count();
+    }
+    catch (...)
+    {
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+
+      std::string reason ("unknown error");
+
+      try
+      {
+        throw;
+      }
+      catch (std::exception const& exception)
+      {
+        reason = exception.what();
+      }
+      catch (...)
+      {
+      }
+
+      report << boost::format (failed_line)
+                % worker_groups[i].hosts.size()
+                % boost::algorithm::join
+                    (worker_groups[i].description.capabilities, ",")
+                % reason;
+    }
+  }
+
+  update_number_of_workers();
+  update_shares();
+
+  std::cout << report.str() << std::flush;
+
+  if (error)
+  {
+    std::rethrow_exception (error);
+  }
 }
 
-void drts_wrapper::add_workers
-  (descriptions_and_entry_points_t const& descriptions_and_entry_points)
+dart::worker_group_startup drts_wrapper::start_worker_group
+  (dart::worker_group const& worker_group)
 {
-  for (auto const& description : descriptions_and_entry_points)
+  auto const start (std::chrono::steady_clock::now());
+
+  std::unique_ptr<gspc::scoped_rifds> rifds
+    (new gspc::scoped_rifds ( gspc::rifd::strategy (worker_group.rifd_options)
+                            , gspc::rifd::hostnames (worker_group.hosts)
+                            , gspc::rifd::port (_vm) // here we need the rifd port
+                            , _gspc_installation
+                            )
+    );
+  gspc::rifd_entry_points const entry_points (rifds->entry_points());
+
+  {
+    std::lock_guard<std::mutex> const lock (_workers_mutex);
+    _worker_rifds.emplace_back (std::move (rifds));
+  }
+
+  auto const bootstrapped (std::chrono::steady_clock::now());
+  std::chrono::steady_clock::time_point worker_start;
+
   {
-    _drts->add_worker
-      ({description.first}, description.second, _certificates);
+    gspc::worker_description description (worker_group.description);
+    description.capabilities.emplace_back (dart::any_location_capability);
 
-    _descriptions_and_entry_points.emplace_front (description);
+    // the runtime system does not document add_worker as thread-safe
+    std::lock_guard<std::mutex> const lock (_add_worker_mutex);
+
+    worker_start = std::chrono::steady_clock::now();
+
+    _drts->add_worker ({description}, entry_points, _certificates);
+  }
+
+  {
+    std::lock_guard<std::mutex> const lock (_workers_mutex);
+    index_workers (worker_group.description, worker_group.hosts);
   }
+
+  return { bootstrapped - start
+         , std::chrono::steady_clock::now() - worker_start
+         };
 }
 
 void drts_wrapper::add_workers (std::string const& nodefile)
@@ -245,7 +350,6 @@ void drts_wrapper::add_workers (std::string const& nodefile)
   add_workers (parse_worker_description_file (nodefile));
 }
 
-
 void drts_wrapper::add_workers
   ( std::string const& machinefile
   , std::size_t workers_per_host
@@ -267,14 +371,6 @@ void drts_wrapper::add_workers
             , std::back_inserter (hosts)
             );
 
-  _worker_rifds.emplace_back
-    (new gspc::scoped_rifds ( gspc::rifd::strategy (_vm)
-                            , gspc::rifd::hostnames (hosts)
-                            , gspc::rifd::port (_vm)
-                            , _gspc_installation
-                            )
-    );
-
   gspc::worker_description const description
     { dart::to_std_vector<std::string> (capabilities)
     , workers_per_host
@@ -284,8 +380,7 @@ void drts_wrapper::add_workers
     , boost::none
     };
 
-  add_workers
-    ({std::make_pair (description, (*_worker_rifds.rbegin())->entry_points())});
+  add_workers ({{description, hosts, _vm}});
 }
 
 void drts_wrapper::add_workers
@@ -295,14 +390,6 @@ void drts_wrapper::add_workers
   , std::size_t shm_size
   )
 {
-  _worker_rifds.emplace_back
-     (new gspc::scoped_rifds ( gspc::rifd::strategy (_vm)
-                             , gspc::rifd::hostnames ( dart::to_std_vector<std::string> (pyhosts))
-                             , gspc::rifd::port (_vm)
-                             , _gspc_installation
-                             )
-     );
-
    gspc::worker_description const description
      { dart::to_std_vector<std::string> (capabilities)
      , workers_per_host
@@ -313,148 +400,461 @@ void drts_wrapper::add_workers
      };
 
    add_workers
-     ({std::make_pair (description, (*_worker_rifds.rbegin())->entry_points())});
+     ({{description, dart::to_std_vector<std::string> (pyhosts), _vm}});
 }
 
-std::list<pnet::type::value::value_type> drts_wrapper::get_location_and_parameters
-  (boost::python::list const& locations_and_parameters)
+void drts_wrapper::add_host_local_workers
+  ( boost::python::list const& pyhosts
+  , std::size_t workers_per_host
+  , boost::python::list const& capabilities
+  , std::size_t shm_size
+  )
 {
-  std::list<pnet::type::value::value_type> required_location_and_parameters;
-
-  boost::python::ssize_t const num_locations_and_params
-    {len (locations_and_parameters)};
+  std::vector<dart::worker_group> worker_groups;
 
-  for (auto i {0}; i < num_locations_and_params; ++i)
+  for (std::string const& host : dart::to_std_vector<std::string> (pyhosts))
   {
-    boost::python::dict const dict_loc_params
-      {locations_and_parameters[i]};
+    std::vector<std::string> host_capabilities
+      (dart::to_std_vector<std::string> (capabilities));
+    host_capabilities.emplace_back (host);
+
+    worker_groups.push_back
+      ( { gspc::worker_description
+            { host_capabilities
+            , workers_per_host
+            , 0
+            , shm_size
+            , boost::none
+            , boost::none
+            }
+        , {host}
+        , _vm
+        }
+      );
+  }
 
-    std::string location;
-    if (dict_loc_params.has_key ("location"))
+  add_workers (worker_groups);
+}
+
+
+namespace
+{
+  //! \note strings are sent utf-8 encoded and handed to the python
+  //! method as str, any other object exporting a contiguous buffer
+  //! (bytes, bytearray, memoryview, numpy arrays, ...) is sent as is
+  //! and handed to the python method as bytes
+  std::pair<we::type::bytearray, bool> to_task_parameters
+    (boost::python::object const& parameter_set)
+  {
+    if (PyUnicode_Check (parameter_set.ptr()))
     {
-      location = {boost::python::extract<std::string> (dict_loc_params["location"])};
-      if (!known_location (location))
+      Py_ssize_t size;
+      char const* data (PyUnicode_AsUTF8AndSize (parameter_set.ptr(), &size));
+
+      if (data == nullptr)
       {
-        stop_runtime();
-        throw std::runtime_error
-          ("No worker is running at location " + location +"!");
+        boost::python::throw_error_already_set();
       }
+
+      return {we::type::bytearray (data, size), false};
     }
 
-    if (!dict_loc_params.has_key ("parameters"))
+    if (!PyObject_CheckBuffer (parameter_set.ptr()))
     {
       throw std::runtime_error
-        ("No key \'parameters\' is specified in the submitted list!");
+        ("The task parameters must be either strings or bytes-like objects!");
     }
 
-    boost::python::list const parameters {dict_loc_params["parameters"]};
-    boost::python::ssize_t const num_parameter_sets {(len (parameters))};
+    Py_buffer view;
 
-    for (auto i {0}; i < num_parameter_sets; ++i)
+    if (PyObject_GetBuffer (parameter_set.ptr(), &view, PyBUF_C_CONTIGUOUS) != 0)
     {
-      std::string parameter_set {boost::python::extract<std::string> (parameters[i])};
+      boost::python::throw_error_already_set();
+    }
 
-      boost::uuids::uuid uuid = _generator();
-      pnetc::type::location_and_parameters::location_and_parameters loc_and_params
-        (boost::uuids::to_string (uuid), location, parameter_set);
+    we::type::bytearray const parameters
+      (static_cast<char const*> (view.buf), view.len);
 
-      required_location_and_parameters.emplace_back
-        (pnetc::type::location_and_parameters::to_value (loc_and_params));
-    }
-  }
+    PyBuffer_Release (&view);
 
-  return required_location_and_parameters;
+    return {parameters, true};
+  }
 }
 
-unsigned long drts_wrapper::get_number_of_tasks
-  (boost::python::list const& locations_and_parameters)
+namespace
 {
-  unsigned long n_tasks = 0;
+  template<typename Fun>
+    void for_each_item (boost::python::object const& iterable, Fun&& fun)
+  {
+    boost::python::handle<> const iterator (PyObject_GetIter (iterable.ptr()));
+
+    while (PyObject* item = PyIter_Next (iterator.get()))
+    {
+      fun (boost::python::object (boost::python::handle<> (item)));
+    }
 
-  boost::python::ssize_t const num_locations_and_params
-     {len (locations_and_parameters)};
+    if (PyErr_Occurred())
+    {
+      boost::python::throw_error_already_set();
+    }
+  }
+}
 
-  for (auto i {0}; i < num_locations_and_params; ++i)
+//! \note the parameters are validated, counted and converted in a
+//! single pass. They are either a flat iterable of parameter sets for
+//! the location given as job option, or an iterable of dictionaries
+//! {'location': ..., 'parameters': <iterable of parameter sets>}.
+//! The tasks are numbered in iteration order, starting at first_task_id.
+//! Returns the number of tasks.
+unsigned long drts_wrapper::add_task_chunks
+  ( std::multimap<std::string, pnet::type::value::value_type>& job_input
+  , boost::python::object const& locations_and_parameters
+  , dart::job_options const& job_options
+  , unsigned long first_task_id
+  )
+{
+  if (job_options.location)
   {
-    boost::python::dict const dict_loc_params (locations_and_parameters[i]);
+    validate_location (*job_options.location);
+
+    return add_task_chunks
+      ( job_input
+      , *job_options.location
+      , locations_and_parameters
+      , job_options.chunksize
+      , first_task_id
+      );
+  }
 
-    if (dict_loc_params.has_key ("location"))
-    {
-      std::string const location
-        {boost::python::extract<std::string> (dict_loc_params["location"])};
+  unsigned long n_tasks (0);
 
-      if (!known_location (location))
+  for_each_item
+    ( locations_and_parameters
+    , [&] (boost::python::object const& entry)
       {
-        stop_runtime();
-        throw std::runtime_error
-          ("No worker is running at location " + location +"!");
+        boost::python::dict const dict_loc_params (entry);
+
+        std::string location;
+        if (dict_loc_params.has_key ("location"))
+        {
+          location = {boost::python::extract<std::string> (dict_loc_params["location"])};
+          validate_location (location);
+        }
+
+        if (!dict_loc_params.has_key ("parameters"))
+        {
+          throw std::runtime_error
+            ("No key \'parameters\' is specified in the submitted list!");
+        }
+
+        n_tasks += add_task_chunks
+          ( job_input
+          , location
+          , dict_loc_params["parameters"]
+          , job_options.chunksize
+          , first_task_id + n_tasks
+          );
       }
-    }
+    );
 
-    if (!dict_loc_params.has_key("parameters"))
-    {
-      throw std::runtime_error
-        ("No key \'parameters\' is specified in the submitted list!");
-    }
+  return n_tasks;
+}
+
+//! \note every chunk of tasks is put as a separate token on the input
+//! port "task_chunk", such that the workflow does not need to split a
+//! list of all the tasks (which is quadratic in the number of tasks)
+unsigned long drts_wrapper::add_task_chunks
+  ( std::multimap<std::string, pnet::type::value::value_type>& job_input
+  , std::string const& location
+  , boost::python::object const& parameters
+  , unsigned long chunksize
+  , unsigned long first_task_id
+  )
+{
+  unsigned long n_tasks (0);
+  std::list<pnet::type::value::value_type> tasks;
+
+  auto const add_chunk
+    ( [&]
+      {
+        job_input.emplace_hint
+          ( job_input.end()
+          , "task_chunk"
+          , pnetc::type::task_chunk::to_value
+              ( pnetc::type::task_chunk::task_chunk
+                  (first_task_id + n_tasks - tasks.size(), location, false, tasks)
+              )
+          );
+
+        tasks.clear();
+      }
+    );
+
+  for_each_item
+    ( parameters
+    , [&] (boost::python::object const& parameter)
+      {
+        auto const parameter_set (to_task_parameters (parameter));
+
+        pnetc::type::location_and_parameters::location_and_parameters loc_and_params
+          ( first_task_id + n_tasks
+          , location
+          , parameter_set.first
+          , parameter_set.second
+          , 0
+          );
+
+        tasks.emplace_back
+          (pnetc::type::location_and_parameters::to_value (loc_and_params));
+        ++n_tasks;
+
+        if (tasks.size() == chunksize)
+        {
+          add_chunk();
+        }
+      }
+    );
 
-    n_tasks += len (dict_loc_params["parameters"]);
+  if (!tasks.empty())
+  {
+    add_chunk();
   }
 
   return n_tasks;
 }
 
+void drts_wrapper::validate_location (std::string const& location)
+{
+  if (!known_location (location))
+  {
+    throw std::invalid_argument
+      ("No worker is running at location " + location +"!");
+  }
+}
+
 namespace
 {
+  //! \note results are read in place from the received values, the
+  //! payload is copied exactly once, into the python bytes object
+  template<typename T>
+    T const& field
+      (pnet::type::value::value_type const& value, std::string const& name)
+  {
+    return boost::get<T> (*pnet::type::value::peek (name, value));
+  }
+
+  //! \note names are interned, such that all the results share a single
+  //! python string per distinct location, host and worker
+  boost::python::object interned (std::string const& name)
+  {
+    PyObject* string
+      (PyUnicode_FromStringAndSize (name.data(), name.size()));
+
+    if (string)
+    {
+      PyUnicode_InternInPlace (&string);
+    }
+
+    return boost::python::object (boost::python::handle<> (string));
+  }
+
+  //! \note results are passed as plain tuples (task_id, location, host,
+  //! worker, start_time, duration, cache_hit, error, result), with either
+  //! error or result being None, to be wrapped into records by the python
+  //! module
+  boost::python::tuple to_python
+    ( pnet::type::value::value_type const& result
+    , boost::python::object const& location
+    , boost::python::object const& host
+    , boost::python::object const& worker
+    )
+  {
+    std::string const& error (field<std::string> (result, "error"));
+
+    if (!error.empty())
+    {
+      return boost::python::make_tuple
+        ( field<unsigned long> (result, "task_id")
+        , location
+        , host
+        , worker
+        , field<unsigned long> (result, "start_time")
+        , field<float> (result, "duration")
+        , field<bool> (result, "cache_hit")
+        , error
+        , boost::python::object()
+        );
+    }
+
+    std::vector<char> const& success
+      (field<we::type::bytearray> (result, "success").v());
+
+    return boost::python::make_tuple
+      ( field<unsigned long> (result, "task_id")
+      , location
+      , host
+      , worker
+      , field<unsigned long> (result, "start_time")
+      , field<float> (result, "duration")
+      , field<bool> (result, "cache_hit")
+      , boost::python::object()
+      , boost::python::object
+          ( boost::python::handle<>
+              (PyBytes_FromStringAndSize (success.data(), success.size()))
+          )
+      );
+  }
+
+  unsigned int intern (dart::job_results& job_results, std::string const& name)
+  {
+    auto const id (job_results.name_ids.find (name));
+
+    if (id != job_results.name_ids.end())
+    {
+      return id->second;
+    }
+
+    job_results.names.emplace_back (name);
+
+    return job_results.name_ids.emplace
+      (name, job_results.names.size() - 1).first->second;
+  }
+
+  //! \note the results arrive in chunks, one per executed task chunk,
+  //! sharing the location, host and worker
+  void append_results
+    ( dart::job_results& job_results
+    , pnet::type::value::value_type const& task_result_chunks
+    )
+  {
+    for ( auto const& chunk
+        : boost::get<std::list<pnet::type::value::value_type>>
+            (task_result_chunks)
+        )
+    {
+      unsigned int const location
+        (intern (job_results, field<std::string> (chunk, "location")));
+      unsigned int const host
+        (intern (job_results, field<std::string> (chunk, "host")));
+      unsigned int const worker
+        (intern (job_results, field<std::string> (chunk, "worker")));
+
+      for ( auto const& result
+          : field<std::list<pnet::type::value::value_type>> (chunk, "results")
+          )
+      {
+        if (job_results.options.max_speculative_chunks != 0)
+        {
+          job_results.durations.emplace_back
+            (field<float> (result, "duration"));
+        }
+
+        job_results.results.push
+          (dart::buffered_result {result, location, host, worker});
+      }
+    }
+  }
+
   boost::python::list extract_results
-    (std::multimap<std::string, pnet::type::value::value_type> const exec_res)
+    (std::multimap<std::string, pnet::type::value::value_type> const& exec_res)
   {
     boost::python::list list_results;
-      auto range (exec_res.equal_range ("task_result"));
+    auto range (exec_res.equal_range ("task_result"));
 
     for ( auto it = range.first
         ; it != range.second
         ; it = std::next (it)
         )
     {
-      boost::python::dict dict_res;
+      for ( auto const& chunk
+          : field<std::list<pnet::type::value::value_type>>
+              (it->second, "chunks")
+          )
+      {
+        boost::python::object const location
+          (interned (field<std::string> (chunk, "location")));
+        boost::python::object const host
+          (interned (field<std::string> (chunk, "host")));
+        boost::python::object const worker
+          (interned (field<std::string> (chunk, "worker")));
+
+        for ( auto const& result
+            : field<std::list<pnet::type::value::value_type>> (chunk, "results")
+            )
+        {
+          list_results.append (to_python (result, location, host, worker));
+        }
+      }
+    }
 
-      auto const result (pnetc::type::task_result::from_value (it->second));
+    return list_results;
+  }
 
-      dict_res["task_id"] = result.task_id;
-      dict_res["location"] = result.location;
-      dict_res["host"] = result.host;
-      dict_res["worker"] = result.worker;
-      dict_res["start_time"] = result.start_time;
-      dict_res["duration"] = result.duration;
+  //! \note the reason why the workflow aborted the job after too many
+  //! failed tasks, none if it was not aborted
+  boost::optional<std::string> failure_summary
+    (std::multimap<std::string, pnet::type::value::value_type> const& exec_res)
+  {
+    auto const summary (exec_res.find ("failure_summary"));
 
-      if (!result.error.empty())
-      {
-        dict_res["error"] = result.error;
-      }
-      else
-      {
-        dict_res["result"] = result.success.to_string();
-      }
+    if ( summary == exec_res.end()
+       || !field<bool> (summary->second, "aborted")
+       )
+    {
+      return boost::none;
+    }
 
-      list_results.append (dict_res);
+    std::ostringstream message;
+    message << "The job was aborted after "
+            << field<unsigned long> (summary->second, "n_failed_tasks")
+            << " of "
+            << field<unsigned long> (summary->second, "n_finished_tasks")
+            << " finished tasks failed, the first errors were:";
+
+    for ( auto const& error
+        : field<std::list<pnet::type::value::value_type>>
+            (summary->second, "first_errors")
+        )
+    {
+      message << "\n" << boost::get<std::string> (error);
     }
 
-    return list_results;
+    return message.str();
   }
 }
 
 boost::python::list drts_wrapper::run
   ( std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
+  )
+{
+  return run (method, locations_and_parameters, std::string());
+}
+
+boost::python::list drts_wrapper::run
+  ( std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , boost::python::dict const& options
   )
 {
-  return run (method, locations_and_parameters, {});
+  return run (method, locations_and_parameters, std::string(), options);
+}
+
+boost::python::list drts_wrapper::run
+  ( std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , std::string const& output_directory
+  )
+{
+  return run
+    (method, locations_and_parameters, output_directory, boost::python::dict());
 }
 
 boost::python::list drts_wrapper::run
   ( std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
   , std::string const& output_directory
+  , boost::python::dict const& options
   )
 {
   return run
@@ -462,370 +862,1629 @@ boost::python::list drts_wrapper::run
     , method
     , locations_and_parameters
     , output_directory
+    , options
     );
 }
 
 boost::python::list drts_wrapper::run
   ( std::string const& abs_path_to_module
   , std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
    )
 {
   return run
-    (abs_path_to_module, method, locations_and_parameters, {});
+    (abs_path_to_module, method, locations_and_parameters, std::string());
 }
 
 boost::python::list drts_wrapper::run
   ( std::string const& abs_path_to_module
   , std::string const& method
-  , boost::python::list const& locations_and_parameters
-  , std::string const& output_directory
+  , boost::python::object const& locations_and_parameters
+  , boost::python::dict const& options
   )
 {
-  boost::filesystem::path const path (abs_path_to_module);
-  std::string const module (path.stem().string());
-
-  unsigned long n_total_tasks (get_number_of_tasks (locations_and_parameters));
-
-  pnetc::type::config::config config
-    ( _python_home.string()
-    , path.parent_path().string()
-    , module
-    , method
-    , output_directory
-    );
-
-  std::multimap<std::string, pnet::type::value::value_type> const exec_res
-    ( gspc::client (*_drts, _certificates).put_and_run
-        ( gspc::workflow (_installation.workflow())
-        , { {"config", pnetc::type::config::to_value (config)}
-          , {"parameter_list", get_location_and_parameters (locations_and_parameters)}
-          , {"n_tasks", n_total_tasks}
-          }
-        )
-    );
-
-  return extract_results (exec_res);
+  return run
+    (abs_path_to_module, method, locations_and_parameters, std::string(), options);
 }
 
-gspc::job_id_t drts_wrapper::async_run
-  ( std::string const& method
-  , boost::python::list const& locations_and_parameters
+boost::python::list drts_wrapper::run
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , boost::python::object const& locations_and_parameters
   , std::string const& output_directory
   )
 {
-  return async_run
-    ( (_installation.home() / "lib/dart_task.py").string()
+  return run
+    ( abs_path_to_module
     , method
     , locations_and_parameters
     , output_directory
+    , boost::python::dict()
     );
 }
 
-gspc::job_id_t drts_wrapper::async_run
-  ( std::string const& method
-  , boost::python::list const& locations_and_parameters
+boost::python::list drts_wrapper::run
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , std::string const& output_directory
+  , boost::python::dict const& options
   )
 {
-  return async_run (method, locations_and_parameters, {});
-}
+  dart::job_options const job_options (get_job_options (options));
+
+  if (job_options.max_undelivered_results != 0)
+  {
+    // nobody would deliver the results while run is waiting for the job
+    throw std::runtime_error
+      ("The job option \"max_undelivered_results\" requires an asynchronous job!");
+  }
+
+  if (job_options.share != 0)
+  {
+    throw std::runtime_error
+      ("The job option \"share\" requires an asynchronous job!");
+  }
+
+  if (job_options.retry_delay != 0)
+  {
+    // the delayed retries are put back into the job by the client
+    throw std::runtime_error
+      ("The job option \"retry_delay\" requires an asynchronous job!");
+  }
+
+  if (job_options.max_speculative_chunks != 0)
+  {
+    // the chunks to execute a second time are requested by the client
+    throw std::runtime_error
+      ("The job option \"max_speculative_chunks\" requires an asynchronous job!");
+  }
+
+  std::multimap<std::string, pnet::type::value::value_type> job_input
+    { { "config"
+      , pnetc::type::config::to_value
+          ( get_config
+              (abs_path_to_module, method, output_directory, job_options)
+          )
+      }
+    , {"end_of_input", 0UL}
+    , {"max_undelivered_results", 0UL}
+    , {"locality_threshold", job_options.locality_threshold}
+    , {"max_running_chunks", 0UL}
+    , {"max_speculative_chunks", job_options.max_speculative_chunks}
+    };
+
+  unsigned long const n_total_tasks
+    (add_task_chunks (job_input, locations_and_parameters, job_options, 0));
+
+  job_input.emplace ("n_tasks", n_total_tasks);
+  job_input.emplace
+    ("n_undispatched_chunks", job_input.count ("task_chunk"));
+
+  std::multimap<std::string, pnet::type::value::value_type> const exec_res
+    ( dart::without_gil
+        ( [&]
+          {
+            job_input.emplace ("n_workers", number_of_workers());
+
+            return client()->put_and_run
+              (gspc::workflow (_installation.workflow()), job_input);
+          }
+        )
+    );
+
+  auto const summary (failure_summary (exec_res));
+
+  if (summary)
+  {
+    throw dart::job_aborted (*summary, extract_results (exec_res));
+  }
+
+  return extract_results (exec_res);
+}
+
+gspc::job_id_t drts_wrapper::async_run
+  ( std::string const& method
+  , boost::python::object const& locations_and_parameters
+  )
+{
+  return async_run (method, locations_and_parameters, std::string());
+}
+
+gspc::job_id_t drts_wrapper::async_run
+  ( std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , boost::python::dict const& options
+  )
+{
+  return async_run (method, locations_and_parameters, std::string(), options);
+}
+
+gspc::job_id_t drts_wrapper::async_run
+  ( std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , std::string const& output_directory
+  )
+{
+  return async_run
+    (method, locations_and_parameters, output_directory, boost::python::dict());
+}
+
+gspc::job_id_t drts_wrapper::async_run
+  ( std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , std::string const& output_directory
+  , boost::python::dict const& options
+  )
+{
+  return async_run
+    ( (_installation.home() / "lib/dart_task.py").string()
+    , method
+    , locations_and_parameters
+    , output_directory
+    , options
+    );
+}
 
 gspc::job_id_t drts_wrapper::async_run
   ( std::string const& abs_path_to_module
   , std::string const& method
-  , boost::python::list const& locations_and_parameters
+  , boost::python::object const& locations_and_parameters
   )
 {
   return async_run
-    (abs_path_to_module, method, locations_and_parameters, {});
+    (abs_path_to_module, method, locations_and_parameters, std::string());
 }
 
 gspc::job_id_t drts_wrapper::async_run
   ( std::string const& abs_path_to_module
   , std::string const& method
-  , boost::python::list const& locations_and_parameters
-  , std::string const& output_directory
+  , boost::python::object const& locations_and_parameters
+  , boost::python::dict const& options
   )
 {
-  boost::filesystem::path const path (abs_path_to_module);
-  std::string const module (path.stem().string());
-  unsigned long n_total_tasks (get_number_of_tasks (locations_and_parameters));
+  return async_run
+    (abs_path_to_module, method, locations_and_parameters, std::string(), options);
+}
 
-  pnetc::type::config::config config
-    ( _python_home.string()
-    , path.parent_path().string()
-    , module
+gspc::job_id_t drts_wrapper::async_run
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , std::string const& output_directory
+  )
+{
+  return async_run
+    ( abs_path_to_module
     , method
+    , locations_and_parameters
     , output_directory
+    , boost::python::dict()
     );
+}
 
-  gspc::job_id_t const job_id
-    ( gspc::client (*_drts, _certificates).submit
-        ( gspc::workflow (_installation.workflow())
-        , { {"config", pnetc::type::config::to_value (config)}
-          , {"parameter_list", get_location_and_parameters (locations_and_parameters)}
-          , {"n_tasks", n_total_tasks}
-          }
-        )
-     );
+gspc::job_id_t drts_wrapper::async_run
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , boost::python::object const& locations_and_parameters
+  , std::string const& output_directory
+  , boost::python::dict const& options
+  )
+{
+  dart::job_options const job_options (get_job_options (options));
+
+  std::multimap<std::string, pnet::type::value::value_type> job_input
+    { { "config"
+      , pnetc::type::config::to_value
+          ( get_config
+              (abs_path_to_module, method, output_directory, job_options)
+          )
+      }
+    , {"end_of_input", 0UL}
+    , {"max_undelivered_results", job_options.max_undelivered_results}
+    , {"locality_threshold", job_options.locality_threshold}
+    , {"max_speculative_chunks", job_options.max_speculative_chunks}
+    };
 
-  _job_results.emplace
-    (std::make_pair
-       ( job_id
-       , std::make_pair (n_total_tasks, std::queue<boost::python::object>())
-       )
+  unsigned long const n_total_tasks
+    (add_task_chunks (job_input, locations_and_parameters, job_options, 0));
+
+  job_input.emplace ("n_tasks", n_total_tasks);
+  job_input.emplace
+    ("n_undispatched_chunks", job_input.count ("task_chunk"));
+
+  return dart::without_gil
+    ( [&]
+      {
+        unsigned long const n_workers (number_of_workers());
+        job_input.emplace ("n_workers", n_workers);
+        unsigned long const n_chunks (job_input.count ("task_chunk"));
+        unsigned long const max_running_chunks
+          (initial_max_running_chunks (job_options, n_chunks));
+        job_input.emplace ("max_running_chunks", max_running_chunks);
+
+        // with a limit on the undelivered results the net is idle
+        // while chunks are held back, the job must wait for finalize
+        gspc::workflow workflow (_installation.workflow());
+        workflow.set_wait_for_output();
+
+        gspc::job_id_t const job_id (client()->submit (workflow, job_input));
+
+        auto job_results (std::make_shared<dart::job_results>());
+        job_results->n_tasks = n_total_tasks;
+        job_results->options = job_options;
+        job_results->n_workers = n_workers;
+        job_results->max_running_chunks = max_running_chunks;
+        job_results->n_pending_chunks = n_chunks;
+
+        {
+          std::lock_guard<std::mutex> const lock (_job_results_mutex);
+          _job_results.emplace (job_id, job_results);
+        }
+
+        // workers added or removed since the submission
+        update_number_of_workers();
+        update_shares();
+
+        if (job_options.share != 0)
+        {
+          start_share_updates();
+        }
+
+        return job_id;
+      }
     );
+}
 
-  return job_id;
+gspc::job_id_t drts_wrapper::open_job
+  ( std::string const& method
+  , boost::python::dict const& options
+  )
+{
+  return open_job
+    ( (_installation.home() / "lib/dart_task.py").string()
+    , method
+    , std::string()
+    , options
+    );
 }
 
-boost::python::list drts_wrapper::collect_results
-  (gspc::job_id_t const& job_id)
+//! \note the job runs until close_job is called and all the tasks put
+//! with put_parameters in between are executed
+gspc::job_id_t drts_wrapper::open_job
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , std::string const& output_directory
+  , boost::python::dict const& options
+  )
 {
-  gspc::client client (*_drts, _certificates);
+  dart::job_options const job_options (get_job_options (options));
+
+  std::multimap<std::string, pnet::type::value::value_type> job_input
+    { { "config"
+      , pnetc::type::config::to_value
+          ( get_config
+              (abs_path_to_module, method, output_directory, job_options)
+          )
+      }
+    , {"n_tasks", 0UL}
+    , {"n_undispatched_chunks", 0UL}
+    , {"max_undelivered_results", job_options.max_undelivered_results}
+    , {"locality_threshold", job_options.locality_threshold}
+    , {"max_speculative_chunks", job_options.max_speculative_chunks}
+    };
+
+  return dart::without_gil
+    ( [&]
+      {
+        unsigned long const n_workers (number_of_workers());
+        job_input.emplace ("n_workers", n_workers);
+        // the chunks are streamed in later, the job may use all workers
+        unsigned long const max_running_chunks
+          (initial_max_running_chunks (job_options, n_workers));
+        job_input.emplace ("max_running_chunks", max_running_chunks);
+
+        gspc::workflow workflow (_installation.workflow());
+        workflow.set_wait_for_output();
+
+        gspc::job_id_t const job_id (client()->submit (workflow, job_input));
+
+        auto job_results (std::make_shared<dart::job_results>());
+        job_results->options = job_options;
+        job_results->accepts_input = true;
+        job_results->n_workers = n_workers;
+        job_results->max_running_chunks = max_running_chunks;
+        job_results->n_pending_chunks = n_workers;
+
+        {
+          std::lock_guard<std::mutex> const lock (_job_results_mutex);
+          _job_results.emplace (job_id, job_results);
+        }
+
+        // workers added or removed since the submission
+        update_number_of_workers();
+        update_shares();
 
-  client.wait (job_id);
+        if (job_options.share != 0)
+        {
+          start_share_updates();
+        }
 
-  return extract_results (client.extract_result_and_forget_job (job_id));
+        return job_id;
+      }
+    );
 }
 
-boost::python::dict drts_wrapper::remove_workers()
+void drts_wrapper::put_parameters
+  ( gspc::job_id_t const& job
+  , boost::python::object const& locations_and_parameters
+  )
 {
-  boost::python::dict errors;
+  auto const job_results (find_job_results (job));
 
-  for (auto const& rifds : _worker_rifds)
+  if (!job_results)
   {
-    gspc::rifd_entry_points entry_points (rifds->entry_points());
+    throw_does_not_accept_parameters (job);
+  }
 
-    std::unordered_map
-      < gspc::rifd_entry_point
-      , std::pair< std::string
-                 , std::unordered_map<pid_t, std::exception_ptr>
-                 >
-      , gspc::rifd_entry_point_hash
-      > const _warnings (_drts->remove_worker (entry_points));
+  std::unique_lock<std::mutex> lock (job_results->input_mutex, std::defer_lock);
+  dart::without_gil ([&] { lock.lock(); });
 
-    for (auto const& w : _warnings)
-    {
-      for (auto const& fail : w.second.second)
-      {
-        std::string excp;
-        try 
+  if (!job_results->accepts_input)
+  {
+    throw_does_not_accept_parameters (job);
+  }
+
+  std::multimap<std::string, pnet::type::value::value_type> task_chunks;
+
+  unsigned long const n_tasks
+    ( add_task_chunks
+        ( task_chunks
+        , locations_and_parameters
+        , job_results->options
+        , job_results->n_tasks
+        )
+    );
+
+  // counted before the chunks are put, such that the remaining tasks
+  // are never under-reported while the workflow is already executing them
+  job_results->n_tasks += n_tasks;
+  job_results->n_chunks += task_chunks.size();
+
+  auto task_chunk (task_chunks.cbegin());
+
+  try
+  {
+    dart::without_gil
+      ( [&]
         {
-          if (fail.second) 
+          for (; task_chunk != task_chunks.cend(); ++task_chunk)
           {
-            std::rethrow_exception (fail.second);
+            client()->put_token (job, "submitted_chunk", task_chunk->second);
           }
-        } catch(const std::exception& e) 
-        {
-          excp = e.what();
         }
-
-        errors[w.first.hostname()]
-          = ( boost::format ("%1%[%2%]: %3%")
-            % w.second.first
-            % fail.first
-            % excp
-            ).str();
-      }
+      );
+  }
+  catch (...)
+  {
+    // the chunks not put are not expected by close_job
+    for (; task_chunk != task_chunks.cend(); ++task_chunk)
+    {
+      job_results->n_tasks -= field<std::list<pnet::type::value::value_type>>
+        (task_chunk->second, "tasks").size();
+      --job_results->n_chunks;
     }
 
-    auto const result (rifds->teardown());
+    throw;
+  }
+}
 
-    for (std::string const& hostname : rifds->hosts())
-    {
-      if (result.second.count (hostname))
-      {
-        errors[hostname] = result.second.at (hostname);
-      }
-    }
+void drts_wrapper::close_job (gspc::job_id_t const& job)
+{
+  auto const job_results (find_job_results (job));
+
+  if (!job_results)
+  {
+    throw_does_not_accept_parameters (job);
   }
 
-  return errors;
+  dart::scoped_gil_release const release;
+
+  std::lock_guard<std::mutex> const lock (job_results->input_mutex);
+
+  if (!job_results->accepts_input)
+  {
+    throw_does_not_accept_parameters (job);
+  }
+
+  client()->put_token (job, "end_of_input", job_results->n_chunks);
+
+  job_results->accepts_input = false;
 }
 
-boost::python::dict drts_wrapper::remove_workers
-  (boost::python::list const& py_hosts)
+boost::python::list drts_wrapper::cancel (gspc::job_id_t const& job)
 {
-  return remove_workers
-    (dart::to_std_vector<std::string> (py_hosts));
+  return cancel (job, false);
 }
 
-boost::python::dict drts_wrapper::remove_workers
-  (std::vector<std::string> const& hosts)
+//! \note no further chunks of the job are dispatched and its input is
+//! closed. Unless interrupted, the chunks already dispatched are still
+//! computed and the call waits for them, otherwise the job is canceled
+//! in the runtime system, aborting the running tasks. Returns the
+//! results not popped so far.
+boost::python::list drts_wrapper::cancel
+  (gspc::job_id_t const& job, bool interrupt)
 {
-  boost::python::dict errors;
+  auto const job_results (find_job_results (job));
 
-  for (auto const& rifds : _worker_rifds)
+  if (!job_results)
   {
-    std::pair< gspc::rifd_entry_points
-             , std::pair< std::unordered_set<std::string>
-                        , std::unordered_set<std::string>
-                        >
-             > const entry_points (rifds->entry_points (hosts));
+    throw std::logic_error
+      ("The job " + job + " is unknown or all its results were retrieved!");
+  }
 
-    std::unordered_set<std::string> const& registered_hosts
-      (entry_points.second.first);
+  dart::without_gil
+    ( [&]
+      {
+        if (!interrupt)
+        {
+          std::lock_guard<std::mutex> const lock (job_results->input_mutex);
 
-    for (std::string const& host : entry_points.second.second)
-    {
-      errors[host] = "unknown host";
-    }
+          if (job_results->finished)
+          {
+            return;
+          }
 
-    std::unordered_map
-      < gspc::rifd_entry_point
-      , std::pair< std::string
-                 , std::unordered_map<pid_t, std::exception_ptr>
-                 >
-      , gspc::rifd_entry_point_hash
-      > const _warnings (_drts->remove_worker (entry_points.first));
+          try
+          {
+            client()->put_token
+              (job, "cancelled", we::type::literal::control());
 
-    for (auto const& w : _warnings)
-    {
-      for (auto const& fail : w.second.second)
-      {
+            if (job_results->accepts_input)
+            {
+              client()->put_token
+                (job, "end_of_input", job_results->n_chunks);
 
-        std::string excp;
-        try 
+              job_results->accepts_input = false;
+            }
+          }
+          catch (...) // the workflow has finished in between
+          {
+          }
+
+          return;
+        }
+
+        // a pop blocked in the workflow holds the mutex of the job until
+        // the job is canceled, which makes its request fail
+        std::unique_lock<std::mutex> lock
+          (job_results->mutex, std::try_to_lock);
+
+        if (lock.owns_lock())
         {
-          if (fail.second) 
+          if (job_results->finished)
           {
-            std::rethrow_exception (fail.second);
+            return;
           }
-        } catch(const std::exception& e) 
+
+          fetch_task_results
+            (job, *job_results, "get_available_task_results");
+
+          if (job_results->finished)
+          {
+            return;
+          }
+        }
+
+        job_results->interrupted = true;
+
+        try
+        {
+          client()->cancel (job);
+        }
+        catch (...) // the workflow has finished in between
+        {
+        }
+
+        if (!lock.owns_lock())
+        {
+          lock.lock();
+        }
+
+        if (!job_results->finished)
+        {
+          extract_job_results (job, *job_results);
+        }
+      }
+    );
+
+  return collect_results (job);
+}
+
+void drts_wrapper::throw_does_not_accept_parameters (gspc::job_id_t const& job)
+{
+  throw std::logic_error
+    ("The job " + job + " does not accept any further parameters!");
+}
+
+std::shared_ptr<dart::job_results> drts_wrapper::find_job_results
+  (gspc::job_id_t const& job)
+{
+  std::lock_guard<std::mutex> const lock (_job_results_mutex);
+
+  auto const job_results (_job_results.find (job));
+
+  return job_results != _job_results.end() ? job_results->second : nullptr;
+}
+
+bool drts_wrapper::all_results_retrieved (gspc::job_id_t const& job)
+{
+  std::lock_guard<std::mutex> const lock (_job_results_mutex);
+
+  return _retrieved_jobs.count (job) != 0;
+}
+
+pnetc::type::config::config drts_wrapper::get_config
+  ( std::string const& abs_path_to_module
+  , std::string const& method
+  , std::string const& output_directory
+  , dart::job_options const& job_options
+  )
+{
+  boost::filesystem::path const path (abs_path_to_module);
+
+  return pnetc::type::config::config
+    ( _python_home.string()
+    , _python_library
+    , path.parent_path().string()
+    , path.stem().string()
+    , method
+    , output_directory
+    , job_options.cache_directory.get_value_or (std::string())
+    , job_options.max_attempts
+    , job_options.retry_delay
+    , job_options.retry_elsewhere
+    , job_options.task_timeout
+    , job_options.max_failures
+    , static_cast<unsigned long> (std::llround (job_options.max_failure_ratio * 1e6))
+    , job_options.failure_ratio_min_tasks
+    , job_options.max_reported_errors
+    );
+}
+
+boost::python::list drts_wrapper::collect_results
+  (gspc::job_id_t const& job_id)
+{
+  if (find_job_results (job_id))
+  {
+    // drain through the workflow until the job has finished: it waits
+    // for its outputs and terminates only once finalize has fired
+    boost::python::list results;
+
+    while (find_job_results (job_id))
+    {
+      try
+      {
+        results.extend
+          (pop_results (job_id, std::numeric_limits<unsigned long>::max()));
+      }
+      catch (dart::job_aborted const& aborted)
+      {
+        throw dart::job_aborted (aborted.what(), results);
+      }
+    }
+
+    return results;
+  }
+
+  if (all_results_retrieved (job_id))
+  {
+    return boost::python::list();
+  }
+
+  std::multimap<std::string, pnet::type::value::value_type> const exec_res
+    ( dart::without_gil
+        ( [&]
+          {
+            client()->wait (job_id);
+
+            return client()->extract_result_and_forget_job (job_id);
+          }
+        )
+    );
+
+  auto const summary (failure_summary (exec_res));
+
+  if (summary)
+  {
+    throw dart::job_aborted (*summary, extract_results (exec_res));
+  }
+
+  return extract_results (exec_res);
+}
+
+namespace
+{
+  boost::python::dict to_python_dict
+    (std::map<std::string, std::string> const& errors)
+  {
+    boost::python::dict dict_errors;
+
+    for (auto const& error : errors)
+    {
+      dict_errors[error.first] = error.second;
+    }
+
+    return dict_errors;
+  }
+}
+
+boost::python::dict drts_wrapper::remove_workers()
+{
+  return to_python_dict
+    ( dart::without_gil
+        ( [this]
+          {
+            auto const removed (remove_all_workers());
+            update_number_of_workers();
+            update_shares();
+            return removed;
+          }
+        )
+    );
+}
+
+boost::python::dict drts_wrapper::remove_workers
+  (boost::python::list const& py_hosts)
+{
+  return remove_workers
+    (dart::to_std_vector<std::string> (py_hosts));
+}
+
+boost::python::dict drts_wrapper::remove_workers
+  (std::vector<std::string> const& hosts)
+{
+  return to_python_dict
+    ( dart::without_gil
+        ( [&]
+          {
+            auto const removed (remove_workers_on (hosts));
+            update_number_of_workers();
+            update_shares();
+            return removed;
+          }
+        )
+    );
+}
+
+std::map<std::string, std::string> drts_wrapper::remove_all_workers()
+{
+  std::map<std::string, std::string> errors;
+
+  std::lock_guard<std::mutex> const lock (_workers_mutex);
+
+  for (auto const& rifds : _worker_rifds)
+  {
+    gspc::rifd_entry_points entry_points (rifds->entry_points());
+
+    std::unordered_map
+      < gspc::rifd_entry_point
+      , std::pair< std::string
+                 , std::unordered_map<pid_t, std::exception_ptr>
+                 >
+      , gspc::rifd_entry_point_hash
+      > const _warnings (_drts->remove_worker (entry_points));
+
+    for (auto const& w : _warnings)
+    {
+      for (auto const& fail : w.second.second)
+      {
+        std::string excp;
+        try 
+        {
+          if (fail.second) 
+          {
+            std::rethrow_exception (fail.second);
+          }
+        } catch(const std::exception& e) 
+        {
+          excp = e.what();
+        }
+
+        errors[w.first.hostname()]
+          = ( boost::format ("%1%[%2%]: %3%")
+            % w.second.first
+            % fail.first
+            % excp
+            ).str();
+      }
+    }
+
+    auto const result (rifds->teardown());
+
+    for (std::string const& hostname : rifds->hosts())
+    {
+      if (result.second.count (hostname))
+      {
+        errors[hostname] = result.second.at (hostname);
+      }
+    }
+  }
+
+  _workers_per_capability.clear();
+  _worker_descriptions_per_host.clear();
+
+  return errors;
+}
+
+std::map<std::string, std::string> drts_wrapper::remove_workers_on
+  (std::vector<std::string> const& hosts)
+{
+  std::map<std::string, std::string> errors;
+
+  std::lock_guard<std::mutex> const lock (_workers_mutex);
+
+  for (auto const& rifds : _worker_rifds)
+  {
+    std::pair< gspc::rifd_entry_points
+             , std::pair< std::unordered_set<std::string>
+                        , std::unordered_set<std::string>
+                        >
+             > const entry_points (rifds->entry_points (hosts));
+
+    std::unordered_set<std::string> const& registered_hosts
+      (entry_points.second.first);
+
+    for (std::string const& host : entry_points.second.second)
+    {
+      errors[host] = "unknown host";
+    }
+
+    std::unordered_map
+      < gspc::rifd_entry_point
+      , std::pair< std::string
+                 , std::unordered_map<pid_t, std::exception_ptr>
+                 >
+      , gspc::rifd_entry_point_hash
+      > const _warnings (_drts->remove_worker (entry_points.first));
+
+    for (auto const& w : _warnings)
+    {
+      for (auto const& fail : w.second.second)
+      {
+
+        std::string excp;
+        try 
+        {
+          if (fail.second) 
+          {
+            std::rethrow_exception (fail.second);
+          }
+        } catch(const std::exception& e) 
+        {
+          excp = e.what();
+        }
+        errors[w.first.hostname()]
+          = ( boost::format ("%1%[%2%]: %3%")
+            % w.second.first
+            % fail.first
+            % excp
+            ).str();
+      }
+    }
+
+    auto const result (rifds->teardown (registered_hosts));
+
+    for (std::string const& hostname : registered_hosts)
+    {
+      if (result.second.count (hostname))
+      {
+        errors[hostname] = result.second.at (hostname);
+      }
+
+      unindex_workers (hostname);
+    }
+  }
+
+  return errors;
+}
+
+unsigned long drts_wrapper::get_number_of_remaining_tasks
+  (gspc::job_id_t const& job)
+{
+  dart::scoped_gil_release const release;
+
+  auto const job_results (find_job_results (job));
+
+  if (!job_results)
+  {
+    if (all_results_retrieved (job))
+    {
+      return 0;
+    }
+
+    throw std::out_of_range ("Unknown job " + job + "!");
+  }
+
+  if (job_results->finished)
+  {
+    return 0;
+  }
+
+  try
+  {
+    job_results->n_remaining_tasks = boost::get<unsigned long>
+      (client()->synchronous_workflow_response
+         (job, "get_number_of_remaining_tasks", 0UL)
+      );
+  }
+  catch (...)
+  {
+    //ignore, the workflow finished in between!
+  }
+
+  return job_results->n_remaining_tasks;
+}
+
+unsigned long drts_wrapper::get_total_number_of_tasks
+  (gspc::job_id_t const& job)
+{
+  auto const job_results (find_job_results (job));
+
+  if (!job_results)
+  {
+    throw std::out_of_range ("Unknown job " + job + "!");
+  }
+
+  return job_results->n_tasks;
+}
+
+void drts_wrapper::fetch_task_results
+  ( gspc::job_id_t const& job
+  , dart::job_results& job_results
+  , std::string const& request
+  )
+{
+  try
+  {
+    append_results
+      ( job_results
+      , client()->synchronous_workflow_response
+          (job, request, std::list<pnet::type::value::value_type>())
+      );
+  }
+  catch (...) // the workflow has finished in between
+  {
+    extract_job_results (job, job_results);
+  }
+}
+
+//! \note a job interrupted by cancel is reported as canceled and has
+//! no results to extract, unless it has finished before
+void drts_wrapper::extract_job_results
+  (gspc::job_id_t const& job, dart::job_results& job_results)
+{
+  if (job_results.interrupted)
+  {
+    try
+    {
+      client()->wait (job);
+    }
+    catch (...) // the job is reported as canceled
+    {
+      client()->forget (job);
+
+      job_results.finished = true;
+
+      update_shares();
+
+      return;
+    }
+  }
+
+  auto const exec_res (client()->extract_result_and_forget_job (job));
+  auto const range (exec_res.equal_range ("task_result"));
+
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    append_results
+      (job_results, *pnet::type::value::peek ("chunks", it->second));
+  }
+
+  job_results.failure_summary = failure_summary (exec_res);
+  job_results.finished = true;
+
+  update_shares();
+}
+
+namespace
+{
+  struct sharing_job
+  {
+    dart::job_options const* options;
+    //! the chunks executing or waiting to be dispatched
+    unsigned long n_pending_chunks;
+  };
+
+  //! \note the workers are shared between the unfinished jobs with a
+  //! share by limiting the number of their chunks executing at the same
+  //! time. The jobs get workers by priority, the ones of the same
+  //! priority split them in proportion to their shares, but no job gets
+  //! more workers than it has pending chunks, such that the workers a
+  //! job can not use go to the others (the jobs with a lower priority
+  //! included). The workers no job can use go to the jobs with the
+  //! highest priority, such that a job that receives more chunks is not
+  //! held back until the next update. Every job executes at least one
+  //! chunk at a time. Lowering a limit does not recall the chunks
+  //! already handed to the scheduler, so a job started later with a
+  //! higher priority waits for at most one chunk per worker.
+  std::vector<unsigned long> shared_max_running_chunks
+    ( std::vector<sharing_job> const& sharing_jobs
+    , unsigned long n_workers
+    )
+  {
+    std::vector<unsigned long> max_running_chunks (sharing_jobs.size(), 0);
+
+    if (sharing_jobs.empty())
+    {
+      return max_running_chunks;
+    }
+
+    std::map<long, std::vector<std::size_t>, std::greater<long>> by_priority;
+
+    for (std::size_t i (0); i < sharing_jobs.size(); ++i)
+    {
+      by_priority[sharing_jobs[i].options->priority].emplace_back (i);
+    }
+
+    unsigned long available (n_workers);
+
+    for (auto& priority : by_priority)
+    {
+      std::vector<std::size_t>& jobs (priority.second);
+
+      // the jobs pending the fewest chunks per share first, such that
+      // the workers they leave go to the others of the same priority
+      std::sort
+        ( jobs.begin()
+        , jobs.end()
+        , [&] (std::size_t lhs, std::size_t rhs)
+          {
+            return sharing_jobs[lhs].n_pending_chunks
+                 * sharing_jobs[rhs].options->share
+                 < sharing_jobs[rhs].n_pending_chunks
+                 * sharing_jobs[lhs].options->share;
+          }
+        );
+
+      unsigned long total_share (0);
+
+      for (std::size_t i : jobs)
+      {
+        total_share += sharing_jobs[i].options->share;
+      }
+
+      for (std::size_t i : jobs)
+      {
+        unsigned long const share (sharing_jobs[i].options->share);
+
+        max_running_chunks[i] = std::min
+          ( sharing_jobs[i].n_pending_chunks
+          , available * share / total_share
+          );
+
+        available -= max_running_chunks[i];
+        total_share -= share;
+      }
+    }
+
+    std::vector<std::size_t> const& top_jobs (by_priority.begin()->second);
+
+    unsigned long top_share (0);
+
+    for (std::size_t i : top_jobs)
+    {
+      top_share += sharing_jobs[i].options->share;
+    }
+
+    unsigned long const unused (available);
+
+    for (std::size_t i : top_jobs)
+    {
+      unsigned long const share (sharing_jobs[i].options->share);
+
+      max_running_chunks[i] += unused * share / top_share;
+    }
+
+    for (auto& max : max_running_chunks)
+    {
+      max = std::max (1UL, max);
+    }
+
+    return max_running_chunks;
+  }
+}
+
+//! \note the pending chunks of each sharing job are asked from its
+//! workflow, a job that has terminated in between has none
+void drts_wrapper::update_shares()
+{
+  std::lock_guard<std::mutex> const lock (_shares_mutex);
+
+  std::vector<std::pair<gspc::job_id_t, std::shared_ptr<dart::job_results>>>
+    sharing_jobs;
+
+  {
+    std::lock_guard<std::mutex> const lock (_job_results_mutex);
+
+    for (auto const& job : _job_results)
+    {
+      if (job.second->options.share != 0 && !job.second->finished)
+      {
+        sharing_jobs.emplace_back (job);
+      }
+    }
+  }
+
+  std::vector<sharing_job> sharing;
+
+  for (auto const& job : sharing_jobs)
+  {
+    try
+    {
+      job.second->n_pending_chunks = boost::get<unsigned long>
+        ( client()->synchronous_workflow_response
+            (job.first, "get_number_of_pending_chunks", 0UL)
+        );
+    }
+    catch (...) // the workflow has finished in between
+    {
+      job.second->n_pending_chunks = 0;
+    }
+
+    sharing.push_back
+      ({&job.second->options, job.second->n_pending_chunks});
+  }
+
+  std::vector<unsigned long> const max_running_chunks
+    (shared_max_running_chunks (sharing, number_of_workers()));
+
+  for (std::size_t i (0); i < sharing_jobs.size(); ++i)
+  {
+    auto const& job (sharing_jobs[i]);
+
+    if (max_running_chunks[i] == job.second->max_running_chunks)
+    {
+      continue;
+    }
+
+    try
+    {
+      client()->put_token
+        (job.first, "new_max_running_chunks", max_running_chunks[i]);
+
+      job.second->max_running_chunks = max_running_chunks[i];
+    }
+    catch (...) // the workflow has finished in between
+    {
+    }
+  }
+}
+
+//! \note the limit a job about to be submitted starts with, such that
+//! none of its chunks are dispatched beyond its share before the shares
+//! are updated. The other jobs are taken with their pending chunks as
+//! of the last update
+unsigned long drts_wrapper::initial_max_running_chunks
+  (dart::job_options const& job_options, unsigned long n_chunks)
+{
+  if (job_options.share == 0)
+  {
+    return 0;
+  }
+
+  std::lock_guard<std::mutex> const lock (_shares_mutex);
+
+  std::vector<sharing_job> sharing;
+
+  {
+    std::lock_guard<std::mutex> const lock (_job_results_mutex);
+
+    for (auto const& job : _job_results)
+    {
+      if (job.second->options.share != 0 && !job.second->finished)
+      {
+        sharing.push_back
+          ({&job.second->options, job.second->n_pending_chunks});
+      }
+    }
+  }
+
+  sharing.push_back ({&job_options, n_chunks});
+
+  return shared_max_running_chunks (sharing, number_of_workers()).back();
+}
+
+//! \note the pending chunks of the jobs change without the client
+//! noticing, hence the shares are updated periodically while the
+//! runtime system is up, once a job with a share was submitted
+void drts_wrapper::start_share_updates()
+{
+  std::lock_guard<std::mutex> const lock (_share_updates_mutex);
+
+  if (_share_updates.joinable())
+  {
+    return;
+  }
+
+  _stop_share_updates = false;
+  _share_updates = std::thread
+    ( [this]
+      {
+        std::unique_lock<std::mutex> lock (_share_updates_mutex);
+
+        while (!_share_updates_stopped.wait_for
+                 ( lock
+                 , std::chrono::milliseconds (100)
+                 , [this] { return _stop_share_updates; }
+                 )
+              )
+        {
+          lock.unlock();
+
+          try
+          {
+            update_shares();
+          }
+          catch (...) // retried with the next update
+          {
+          }
+
+          lock.lock();
+        }
+      }
+    );
+}
+
+void drts_wrapper::stop_share_updates()
+{
+  {
+    std::lock_guard<std::mutex> const lock (_share_updates_mutex);
+
+    if (!_share_updates.joinable())
+    {
+      return;
+    }
+
+    _stop_share_updates = true;
+  }
+
+  _share_updates_stopped.notify_all();
+  _share_updates.join();
+}
+
+//! \note the workflow of each unfinished job routes the chunks held
+//! back at busy locations by comparing its outstanding chunks with the
+//! number of workers
+void drts_wrapper::update_number_of_workers()
+{
+  std::lock_guard<std::mutex> const lock (_shares_mutex);
+
+  std::vector<std::pair<gspc::job_id_t, std::shared_ptr<dart::job_results>>>
+    unfinished_jobs;
+
+  {
+    std::lock_guard<std::mutex> const lock (_job_results_mutex);
+
+    for (auto const& job : _job_results)
+    {
+      if (!job.second->finished)
+      {
+        unfinished_jobs.emplace_back (job);
+      }
+    }
+  }
+
+  unsigned long const n_workers (number_of_workers());
+
+  for (auto const& job : unfinished_jobs)
+  {
+    if (n_workers == job.second->n_workers)
+    {
+      continue;
+    }
+
+    try
+    {
+      client()->put_token (job.first, "new_n_workers", n_workers);
+
+      job.second->n_workers = n_workers;
+    }
+    catch (...) // the workflow has finished in between
+    {
+    }
+  }
+}
+
+unsigned long drts_wrapper::number_of_workers()
+{
+  std::lock_guard<std::mutex> const lock (_workers_mutex);
+
+  unsigned long n_workers (0);
+
+  for (auto const& descriptions : _worker_descriptions_per_host)
+  {
+    for (auto const& description : descriptions.second)
+    {
+      n_workers += description.num_per_node;
+    }
+  }
+
+  return n_workers;
+}
+
+boost::python::list drts_wrapper::pop_results
+  (gspc::job_id_t const& job, unsigned long max_n)
+{
+  return pop_results (job, max_n, -1.0);
+}
+
+//! \note all results available in the workflow are transferred with a
+//! single response and buffered on the client. A negative timeout
+//! blocks until at least one result is available, otherwise the
+//! workflow is polled until the timeout (in seconds) expires. Calls
+//! for the same job are serialized, calls for different jobs are not.
+boost::python::list drts_wrapper::pop_results
+  ( gspc::job_id_t const& job
+  , unsigned long max_n
+  , double timeout
+  )
+{
+  auto const job_results (find_job_results (job));
+
+  if (!job_results)
+  {
+    if (all_results_retrieved (job))
+    {
+      return boost::python::list();
+    }
+
+    throw std::invalid_argument ("The job " + job + " is unknown!");
+  }
+
+  std::list<dart::buffered_result> popped;
+  std::vector<std::string const*> names;
+  boost::optional<std::string> failure_summary;
+
+  dart::without_gil
+    ( [&]
+      {
+        std::lock_guard<std::mutex> const lock (job_results->mutex);
+
+        wait_for_task_results (job, *job_results, max_n, timeout);
+
+        for (std::string const& name : job_results->names)
+        {
+          names.emplace_back (&name);
+        }
+
+        for ( unsigned long n (0)
+            ; n < max_n && !job_results->results.empty()
+            ; ++n
+            )
         {
-          excp = e.what();
+          popped.emplace_back (std::move (job_results->results.front()));
+          job_results->results.pop();
         }
-        errors[w.first.hostname()]
-          = ( boost::format ("%1%[%2%]: %3%")
-            % w.second.first
-            % fail.first
-            % excp
-            ).str();
-      }
-    }
 
-    auto const result (rifds->teardown (registered_hosts));
+        // an aborted job is kept until a call finds no results, which
+        // then reports why the job was aborted
+        if ( job_results->finished && job_results->results.empty()
+           && (!job_results->failure_summary || popped.empty())
+           )
+        {
+          failure_summary = job_results->failure_summary;
 
-    for (std::string const& hostname : registered_hosts)
-    {
-      if (result.second.count (hostname))
-      {
-        errors[hostname] = result.second.at (hostname);
+          std::lock_guard<std::mutex> const lock (_job_results_mutex);
+          _job_results.erase (job);
+          _retrieved_jobs.emplace (job);
+        }
       }
-    }
+    );
+
+  if (failure_summary)
+  {
+    throw dart::job_aborted (*failure_summary);
   }
 
-  return errors;
-}
+  std::vector<boost::python::object> python_names (names.size());
+  auto const python_name
+    ( [&] (unsigned int id) -> boost::python::object const&
+      {
+        if (python_names[id].ptr() == Py_None)
+        {
+          python_names[id] = interned (*names[id]);
+        }
 
-unsigned long drts_wrapper::get_number_of_remaining_tasks
-  (gspc::job_id_t const& job)
-{
-  gspc::client client (*_drts, _certificates);
+        return python_names[id];
+      }
+    );
 
-  static unsigned long n_left_tasks (0);
+  boost::python::list results;
 
-  try
+  for (auto const& result : popped)
   {
-    n_left_tasks = boost::get<unsigned long>
-      (client.synchronous_workflow_response
-         (job, "get_number_of_remaining_tasks", 0UL)
+    results.append
+      ( to_python
+          ( result.result
+          , python_name (result.location)
+          , python_name (result.host)
+          , python_name (result.worker)
+          )
       );
   }
-  catch (...)
-  {
-    //ignore, the workflow finished in between!
-  }
 
-  return n_left_tasks;
+  return results;
 }
 
-unsigned long drts_wrapper::get_total_number_of_tasks
-  (gspc::job_id_t const& job)
+//! \note a chunk the tasks of which are all retried delivers no
+//! results, hence the workflow is asked again until results arrive.
+//! While retries of the job are delayed or chunks may be speculated on,
+//! the workflow is polled instead of waited for, such that the retries
+//! are put back and the stragglers are noticed in time.
+void drts_wrapper::wait_for_task_results
+  ( gspc::job_id_t const& job
+  , dart::job_results& job_results
+  , unsigned long max_n
+  , double timeout
+  )
 {
-  return _job_results.at (job).first;
-}
+  resubmit_delayed_retries (job, job_results);
+  speculate_on_stragglers (job, job_results);
 
-boost::python::object drts_wrapper::get_next_task_result
-  (gspc::client& client, gspc::job_id_t const& job)
-{
-  pnetc::type::task_result::task_result result;
+  if (!job_results.finished && job_results.results.size() < max_n)
+  {
+    fetch_task_results
+      (job, job_results, "get_available_task_results");
+  }
 
-  pnet::type::value::value_type response
-    (client.synchronous_workflow_response
-       (job, "get_next_task_result", pnetc::type::task_result::to_value (result))
+  auto const deadline
+    ( timeout < 0
+    ? std::chrono::steady_clock::time_point::max()
+    : std::chrono::steady_clock::now()
+    + std::chrono::duration_cast<std::chrono::steady_clock::duration>
+        (std::chrono::duration<double> (timeout))
     );
+  std::chrono::milliseconds interval (1);
+
+  while ( !job_results.finished
+        && job_results.results.empty()
+        && std::chrono::steady_clock::now() < deadline
+        )
+  {
+    if ( timeout < 0 && job_results.delayed_retries.empty()
+       && job_results.options.max_speculative_chunks == 0
+       )
+    {
+      fetch_task_results (job, job_results, "get_next_task_results");
+      resubmit_delayed_retries (job, job_results);
+
+      continue;
+    }
+
+    std::this_thread::sleep_until
+      ( std::min
+          ( { std::chrono::steady_clock::now() + interval
+            , deadline
+            , job_results.delayed_retries.empty()
+              ? deadline
+              : job_results.delayed_retries.begin()->first
+            }
+          )
+      );
+    interval = std::min (2 * interval, std::chrono::milliseconds (100));
 
-  result = pnetc::type::task_result::from_value (response);
+    resubmit_delayed_retries (job, job_results);
+    speculate_on_stragglers (job, job_results);
+    fetch_task_results
+      (job, job_results, "get_available_task_results");
+  }
+}
 
-  boost::python::dict dict_res;
+//! \note the n-th retry of a task is delayed by retry_delay seconds
+//! doubled n - 1 times, once for the whole chunk of retried tasks
+void drts_wrapper::resubmit_delayed_retries
+  (gspc::job_id_t const& job, dart::job_results& job_results)
+{
+  if (job_results.finished || job_results.options.retry_delay == 0)
+  {
+    return;
+  }
 
-  dict_res["task_id"] = result.task_id;
-  dict_res["location"] = result.location;
-  dict_res["host"] = result.host;
-  dict_res["worker"] = result.worker;
-  dict_res["start_time"] = result.start_time;
-  dict_res["duration"] = result.duration;
+  auto const now (std::chrono::steady_clock::now());
+  pnet::type::value::value_type retry_chunks;
 
-  if (!result.error.empty())
+  try
+  {
+    retry_chunks = client()->synchronous_workflow_response
+      ( job
+      , "get_delayed_retry_chunks"
+      , std::list<pnet::type::value::value_type>()
+      );
+  }
+  catch (...)
   {
-    dict_res["error"] = result.error;
+    // the workflow has finished in between, noticed when fetching the
+    // results. A job waits for its outputs, such that it can not finish
+    // while retries are held back here
+    if (!job_results.delayed_retries.empty())
+    {
+      throw;
+    }
+
+    return;
   }
-  else
+
+  for ( auto const& chunk
+      : boost::get<std::list<pnet::type::value::value_type>> (retry_chunks)
+      )
   {
-    dict_res["result"] = result.success.to_string();
+    auto const attempt
+      ( pnetc::type::location_and_parameters::from_value
+          (pnetc::type::task_chunk::from_value (chunk).tasks.front())
+      . attempt
+      );
+
+    job_results.delayed_retries.emplace
+      ( now
+      + std::chrono::duration_cast<std::chrono::steady_clock::duration>
+          ( std::chrono::duration<double>
+              (job_results.options.retry_delay * std::pow (2.0, attempt - 1))
+          )
+      , chunk
+      );
   }
 
-  return dict_res;
+  while ( !job_results.delayed_retries.empty()
+        && job_results.delayed_retries.begin()->first <= now
+        )
+  {
+    client()->put_token
+      (job, "due_retry_chunk", job_results.delayed_retries.begin()->second);
+
+    job_results.delayed_retries.erase (job_results.delayed_retries.begin());
+  }
 }
 
-boost::python::object drts_wrapper::pop_result (gspc::job_id_t const& job)
+//! \note the workflow reports its running chunks once all chunks are
+//! dispatched, a chunk counts as running since it was first reported.
+//! A chunk running longer than speculation_factor times the median
+//! duration of the tasks fetched so far (times the chunksize) is
+//! requested to be executed a second time, at most once
+void drts_wrapper::speculate_on_stragglers
+  (gspc::job_id_t const& job, dart::job_results& job_results)
 {
-  boost::python::object result;
-  auto& job_results (_job_results[job]);
-  gspc::client client (*_drts, _certificates);
+  if ( job_results.finished
+     || job_results.options.max_speculative_chunks == 0
+     )
+  {
+    return;
+  }
+
+  pnet::type::value::value_type running_chunks;
 
   try
   {
-    job_results.second.push (get_next_task_result (client, job));
+    running_chunks = client()->synchronous_workflow_response
+      (job, "get_running_chunks", 0UL);
   }
   catch (...) // the workflow has finished in between
   {
-    if (job_results.second.empty())
+    return;
+  }
+
+  auto const now (std::chrono::steady_clock::now());
+  std::unordered_map<unsigned long, std::chrono::steady_clock::time_point>
+    running_since;
+
+  for ( auto const& value
+      : boost::get<std::set<pnet::type::value::value_type>> (running_chunks)
+      )
+  {
+    unsigned long const id (boost::get<unsigned long> (value));
+    auto const since (job_results.running_since.find (id));
+
+    running_since.emplace
+      (id, since == job_results.running_since.end() ? now : since->second);
+  }
+
+  job_results.running_since = std::move (running_since);
+
+  if (job_results.durations.empty())
+  {
+    return;
+  }
+
+  auto const median
+    (job_results.durations.begin() + job_results.durations.size() / 2);
+  std::nth_element
+    (job_results.durations.begin(), median, job_results.durations.end());
+
+  auto const straggling
+    ( std::chrono::duration_cast<std::chrono::steady_clock::duration>
+        ( std::chrono::duration<double>
+            ( job_results.options.speculation_factor
+            * *median
+            * job_results.options.chunksize
+            )
+        )
+    );
+
+  for (auto const& chunk : job_results.running_since)
+  {
+    if ( now - chunk.second <= straggling
+       || !job_results.speculation_requests.emplace (chunk.first).second
+       )
     {
-      auto const last_results
-        (extract_results (client.extract_result_and_forget_job (job)));
+      continue;
+    }
 
-      for (boost::python::ssize_t i = 0; i < len (last_results); ++i)
-      {
-        job_results.second.push (last_results[i]);
-      }
+    try
+    {
+      client()->put_token (job, "speculation_request", chunk.first);
+    }
+    catch (...) // the workflow has finished in between
+    {
+      return;
     }
   }
+}
 
-  if (job_results.second.size() == 0)
+boost::python::object drts_wrapper::pop_result (gspc::job_id_t const& job)
+{
+  boost::python::list const results (pop_results (job, 1));
+
+  if (len (results) == 0)
   {
-    throw std::logic_error
-      ("No results are left. All results were retrieved!");
+    return boost::python::object();
   }
-  else
-  {
-    result = job_results.second.front();
-    job_results.second.pop();
 
-    if (job_results.second.empty())
+  return results[0];
+}
+
+//! \note the client is created on first use and kept for the lifetime
+//! of the runtime system, such that its connection (and, when using
+//! certificates, the handshake) is not repeated for every request. Each
+//! call holds its own reference, such that stop_runtime does not
+//! destroy the client while another thread is still using it
+std::shared_ptr<gspc::client> drts_wrapper::client()
+{
+  std::lock_guard<std::mutex> const lock (_client_mutex);
+
+  if (!_client)
+  {
+    if (!_drts)
     {
-      _job_results.erase (job);
+      throw std::logic_error ("The runtime system is not started!");
     }
 
-    return result;
+    _client = std::make_shared<gspc::client> (*_drts, _certificates);
   }
+
+  return _client;
 }
 
 void drts_wrapper::stop_runtime()
 {
-  remove_workers();
+  dart::scoped_gil_release const release;
+
+  stop_share_updates();
+
+  remove_all_workers();
+
+  std::lock_guard<std::mutex> const lock (_client_mutex);
+
+  _client.reset();
   _drts.reset();
   _master_rifd.reset();
 }
@@ -941,18 +2600,258 @@ boost::program_options::variables_map drts_wrapper::get_options
   return vm;
 }
 
+dart::job_options drts_wrapper::get_job_options
+  (boost::python::dict const& options)
+{
+  dart::job_options job_options;
+
+  boost::python::list const keys (options.keys());
+
+  for (boost::python::ssize_t i = 0; i < len (keys); ++i)
+  {
+    std::string const key {boost::python::extract<std::string> (keys[i])};
+
+    if (key == "chunksize")
+    {
+      int const chunksize (extract_int (options[key]));
+
+      if (chunksize < 1)
+      {
+        throw std::runtime_error ("The chunksize must be positive!");
+      }
+
+      job_options.chunksize = chunksize;
+    }
+    else if (key == "max_undelivered_results")
+    {
+      int const max_undelivered_results (extract_int (options[key]));
+
+      if (max_undelivered_results < 0)
+      {
+        throw std::runtime_error
+          ("The maximum number of undelivered results must not be negative!");
+      }
+
+      job_options.max_undelivered_results = max_undelivered_results;
+    }
+    else if (key == "max_attempts")
+    {
+      int const max_attempts (extract_int (options[key]));
+
+      if (max_attempts < 1)
+      {
+        throw std::runtime_error
+          ("The maximum number of attempts must be positive!");
+      }
+
+      job_options.max_attempts = max_attempts;
+    }
+    else if (key == "retry_delay")
+    {
+      double const retry_delay
+        (boost::python::extract<double> (options[key].attr ("__float__")()));
+
+      if (!(retry_delay >= 0))
+      {
+        throw std::runtime_error ("The retry delay must not be negative!");
+      }
+
+      job_options.retry_delay = retry_delay;
+    }
+    else if (key == "retry_elsewhere")
+    {
+      job_options.retry_elsewhere = boost::python::extract<bool> (options[key]);
+    }
+    else if (key == "task_timeout")
+    {
+      double const task_timeout
+        (boost::python::extract<double> (options[key].attr ("__float__")()));
+
+      if (!(task_timeout >= 0))
+      {
+        throw std::runtime_error ("The task timeout must not be negative!");
+      }
+
+      job_options.task_timeout = task_timeout;
+    }
+    else if (key == "max_failures")
+    {
+      int const max_failures (extract_int (options[key]));
+
+      if (max_failures < 0)
+      {
+        throw std::runtime_error
+          ("The maximum number of failures must not be negative!");
+      }
+
+      job_options.max_failures = max_failures;
+    }
+    else if (key == "max_failure_ratio")
+    {
+      double const max_failure_ratio
+        (boost::python::extract<double> (options[key].attr ("__float__")()));
+
+      if (!(max_failure_ratio >= 0 && max_failure_ratio <= 1))
+      {
+        throw std::runtime_error
+          ("The maximum failure ratio must be between 0 and 1!");
+      }
+
+      job_options.max_failure_ratio = max_failure_ratio;
+    }
+    else if (key == "failure_ratio_min_tasks")
+    {
+      int const failure_ratio_min_tasks (extract_int (options[key]));
+
+      if (failure_ratio_min_tasks < 0)
+      {
+        throw std::runtime_error
+          ("The minimum number of tasks for the failure ratio must not be negative!");
+      }
+
+      job_options.failure_ratio_min_tasks = failure_ratio_min_tasks;
+    }
+    else if (key == "max_reported_errors")
+    {
+      int const max_reported_errors (extract_int (options[key]));
+
+      if (max_reported_errors < 0)
+      {
+        throw std::runtime_error
+          ("The number of reported errors must not be negative!");
+      }
+
+      job_options.max_reported_errors = max_reported_errors;
+    }
+    else if (key == "max_speculative_chunks")
+    {
+      int const max_speculative_chunks (extract_int (options[key]));
+
+      if (max_speculative_chunks < 0)
+      {
+        throw std::runtime_error
+          ("The maximum number of speculative chunks must not be negative!");
+      }
+
+      job_options.max_speculative_chunks = max_speculative_chunks;
+    }
+    else if (key == "speculation_factor")
+    {
+      double const speculation_factor
+        (boost::python::extract<double> (options[key].attr ("__float__")()));
+
+      if (!(speculation_factor > 0))
+      {
+        throw std::runtime_error ("The speculation factor must be positive!");
+      }
+
+      job_options.speculation_factor = speculation_factor;
+    }
+    else if (key == "share")
+    {
+      int const share (extract_int (options[key]));
+
+      if (share < 1)
+      {
+        throw std::runtime_error ("The share must be positive!");
+      }
+
+      job_options.share = share;
+    }
+    else if (key == "priority")
+    {
+      job_options.priority = extract_int (options[key]);
+    }
+    else if (key == "locality_threshold")
+    {
+      int const locality_threshold (extract_int (options[key]));
+
+      if (locality_threshold < 0)
+      {
+        throw std::runtime_error
+          ("The locality threshold must not be negative!");
+      }
+
+      job_options.locality_threshold = locality_threshold;
+    }
+    else if (key == "location")
+    {
+      job_options.location
+        = std::string (boost::python::extract<std::string> (options[key]));
+    }
+    else if (key == "cache_directory")
+    {
+      job_options.cache_directory
+        = std::string (boost::python::extract<std::string> (options[key]));
+
+      if (job_options.cache_directory->empty())
+      {
+        throw std::runtime_error ("The cache directory must not be empty!");
+      }
+    }
+    else
+    {
+      throw std::runtime_error ("Unknown job option \"" + key + "\"!");
+    }
+  }
+
+  return job_options;
+}
+
 bool drts_wrapper::known_location (std::string const& location)
 {
-  for (auto const& desc : _descriptions_and_entry_points)
+  return get_number_of_workers_with_capability (location) != 0;
+}
+
+unsigned long drts_wrapper::get_number_of_workers_with_capability
+  (std::string const& capability)
+{
+  std::lock_guard<std::mutex> const lock (_workers_mutex);
+
+  auto const workers (_workers_per_capability.find (capability));
+
+  return workers != _workers_per_capability.end() ? workers->second : 0;
+}
+
+void drts_wrapper::index_workers
+  ( gspc::worker_description const& description
+  , std::vector<std::string> const& hosts
+  )
+{
+  for (std::string const& host : hosts)
   {
-    if ( std::find ( desc.first.capabilities.begin()
-                   , desc.first.capabilities.end()
-                   , location
-                   )
-       !=  desc.first.capabilities.end()
-       )
-    { return true; }
+    _worker_descriptions_per_host[host].emplace_back (description);
+
+    for (std::string const& capability : description.capabilities)
+    {
+      _workers_per_capability[capability] += description.num_per_node;
+    }
+  }
+}
+
+void drts_wrapper::unindex_workers (std::string const& host)
+{
+  auto const descriptions (_worker_descriptions_per_host.find (host));
+
+  if (descriptions == _worker_descriptions_per_host.end())
+  {
+    return;
+  }
+
+  for (auto const& description : descriptions->second)
+  {
+    for (std::string const& capability : description.capabilities)
+    {
+      auto workers (_workers_per_capability.find (capability));
+
+      workers->second -= std::min (workers->second, description.num_per_node);
+
+      if (workers->second == 0)
+      {
+        _workers_per_capability.erase (workers);
+      }
+    }
   }
 
-  return false;
+  _worker_descriptions_per_host.erase (descriptions);
 }
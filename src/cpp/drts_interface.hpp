@@ -1,31 +1,179 @@
 #include <installation.hpp>
 
 #include <drts/certificates.hpp>
+#include <drts/client.hpp>
 #include <drts/information_to_reattach.hpp>
 #include <drts/scoped_rifd.hpp>
+#include <drts/worker_description.hpp>
 
 #include <pnetc/type/config.hpp>
 #include <pnetc/type/task_result.hpp>
 
 #include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
 #include <boost/program_options.hpp>
 #include <boost/python.hpp>
-#include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-#include <boost/uuid/uuid_io.hpp>
 
-#include <forward_list>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <queue>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
-namespace
+namespace dart
 {
-  using descriptions_and_entry_points_t
-    = std::forward_list< std::pair< gspc::worker_description
-                                  , gspc::rifd_entry_points
-                                  >
-                       >;
+  //! \note capability every worker is started with in addition to its
+  //! location, required by the task chunks that were allowed to leave
+  //! their location (see the route_task_chunk transition of the workflow)
+  constexpr char const any_location_capability[] = "dart_any_location";
+
+  //! \note per job options, given as keyword arguments to run/async_run
+  struct job_options
+  {
+    //! number of parameter sets executed by a single task
+    unsigned long chunksize {1};
+    //! maximum number of results held in the workflow until popped by
+    //! the client, 0 for no limit
+    unsigned long max_undelivered_results {0};
+    //! the number of chunks of a location executing or waiting for a
+    //! worker there, at which further chunks of the location are held
+    //! back until a worker elsewhere is idle, 0 to always wait for the
+    //! location
+    unsigned long locality_threshold {0};
+    //! the maximum number of chunks executed a second time at once, once
+    //! all chunks are dispatched, 0 for no speculative execution, and
+    //! how many times longer than the median task duration times the
+    //! chunksize a chunk must run to be executed a second time
+    unsigned long max_speculative_chunks {0};
+    double speculation_factor {2};
+    //! when given, the parameters are a flat iterable of parameter sets
+    //! to be executed at this location
+    boost::optional<std::string> location;
+    //! when given, the results of succeeded tasks are stored in and
+    //! taken from this directory, see result_cache
+    boost::optional<std::string> cache_directory;
+    //! the number of times a task is executed at most until it succeeds,
+    //! the delay before the first retry in seconds, doubled with every
+    //! further retry, and whether retries may run at any location
+    unsigned long max_attempts {1};
+    double retry_delay {0};
+    bool retry_elsewhere {false};
+    //! the seconds after which a task is aborted, 0 for no limit
+    double task_timeout {0};
+    //! the job is aborted once max_failures tasks failed (0 for no
+    //! limit) or, once failure_ratio_min_tasks tasks finished, once the
+    //! ratio of failed to finished tasks exceeds max_failure_ratio
+    unsigned long max_failures {0};
+    double max_failure_ratio {1};
+    unsigned long failure_ratio_min_tasks {1};
+    //! the number of first errors reported when the job is aborted
+    unsigned long max_reported_errors {5};
+    //! the weight of the job when sharing the workers with other jobs,
+    //! 0 for jobs that are not limited
+    unsigned long share {0};
+    //! only the sharing jobs with the highest priority split the workers
+    long priority {0};
+  };
+
+  //! \note raised once the results of a job that was aborted after too
+  //! many failed tasks were delivered, tells why
+  struct job_aborted : std::runtime_error
+  {
+    job_aborted
+      ( std::string const& reason
+      , boost::python::list results = boost::python::list()
+      )
+        : std::runtime_error (reason)
+        , results (results)
+    {}
+
+    //! the results delivered by the call that raised
+    boost::python::list results;
+  };
+
+  //! \note a task result fetched from the workflow, its location, host
+  //! and worker are indices into the names of its job
+  struct buffered_result
+  {
+    pnet::type::value::value_type result;
+    unsigned int location;
+    unsigned int host;
+    unsigned int worker;
+  };
+
+  //! \note client side state of an asynchronously submitted job, the
+  //! mutex serializes fetching and popping its results, the input_mutex
+  //! serializes streaming parameters into it. Neither is waited for
+  //! while holding the python global interpreter lock.
+  struct job_results
+  {
+    std::mutex mutex;
+    std::mutex input_mutex;
+    std::atomic<unsigned long> n_tasks {0};
+    //! the number of remaining tasks last reported by the workflow
+    std::atomic<unsigned long> n_remaining_tasks {0};
+    //! for jobs opened with open_job: the options of the job, the
+    //! number of chunks streamed into it and whether close_job is pending
+    job_options options;
+    unsigned long n_chunks {0};
+    bool accepts_input {false};
+    //! results fetched from the workflow but not yet popped
+    std::queue<buffered_result> results;
+    //! chunks of failed tasks to put back into the workflow once their
+    //! retry delay has passed
+    std::multimap<std::chrono::steady_clock::time_point, pnet::type::value::value_type>
+      delayed_retries;
+    //! with speculative execution: the durations of the fetched results,
+    //! when each running chunk was first reported and the chunks to
+    //! execute a second time requested so far
+    std::vector<float> durations;
+    std::unordered_map<unsigned long, std::chrono::steady_clock::time_point>
+      running_since;
+    std::unordered_set<unsigned long> speculation_requests;
+    //! the distinct location, host and worker names of the results,
+    //! each stored once, references stay valid when names are added
+    std::deque<std::string> names;
+    std::unordered_map<std::string, unsigned int> name_ids;
+    //! the workflow has terminated and its results were extracted
+    std::atomic<bool> finished {false};
+    //! cancel has interrupted the job in the runtime system
+    std::atomic<bool> interrupted {false};
+    //! why the workflow aborted the job, reported once all its results
+    //! were popped
+    boost::optional<std::string> failure_summary;
+    //! the number of chunks the job may execute at the same time, as
+    //! last set by update_shares (guarded by its mutex)
+    unsigned long max_running_chunks {0};
+    //! the number of workers the workflow routes chunks for, as last
+    //! set by update_number_of_workers (guarded by the same mutex)
+    unsigned long n_workers {0};
+    //! the chunks executing or waiting to be dispatched, as last asked
+    //! by update_shares (guarded by its mutex)
+    unsigned long n_pending_chunks {0};
+  };
+
+  //! \note hosts sharing a worker description, bootstrapped together
+  struct worker_group
+  {
+    gspc::worker_description description;
+    std::vector<std::string> hosts;
+    boost::program_options::variables_map rifd_options;
+  };
+
+  struct worker_group_startup
+  {
+    std::chrono::duration<double> bootstrap;
+    std::chrono::duration<double> worker_start;
+  };
 }
 
 class drts_wrapper : boost::noncopyable
@@ -35,6 +183,7 @@ public:
     ( std::string const& anaconda_home
     , boost::python::dict const&
     );
+  ~drts_wrapper();
 
   void start_runtime();
   void start_runtime (std::string const& nodefile);
@@ -56,6 +205,15 @@ public:
     , boost::python::list const& capabilities
     , std::size_t shm_size
     );
+  //! \note the workers on each host get the host name as additional
+  //! capability, such that tasks can be executed at the host holding
+  //! their input
+  void add_host_local_workers
+    ( boost::python::list const& pyhosts
+    , std::size_t workers_per_host
+    , boost::python::list const& capabilities
+    , std::size_t shm_size
+    );
 
   boost::python::dict remove_workers();
   boost::python::dict remove_workers (boost::python::list const&);
@@ -63,52 +221,130 @@ public:
 
   boost::python::list run
     ( std::string const& method
-    , boost::python::list const& locations_and_parameters
+    , boost::python::object const& locations_and_parameters
     );
 
   boost::python::list run
     ( std::string const& method
-    , boost::python::list const& locations_and_parameters
+    , boost::python::object const& locations_and_parameters
+    , boost::python::dict const& options
+    );
+
+  boost::python::list run
+    ( std::string const& method
+    , boost::python::object const& locations_and_parameters
     , std::string const& output_directory
     );
 
+  boost::python::list run
+    ( std::string const& method
+    , boost::python::object const& locations_and_parameters
+    , std::string const& output_directory
+    , boost::python::dict const& options
+    );
+
+  boost::python::list run
+    ( std::string const& abs_path_to_module
+    , std::string const& method
+    , boost::python::object const& locations_and_parameters
+    );
+
+  boost::python::list run
+    ( std::string const& abs_path_to_module
+    , std::string const& method
+    , boost::python::object const& locations_and_parameters
+    , boost::python::dict const& options
+    );
+
   boost::python::list run
     ( std::string const& abs_path_to_module
     , std::string const& method
-    , boost::python::list const& locations_and_parameters
+    , boost::python::object const& locations_and_parameters
+    , std::string const& output_directory
     );
 
   boost::python::list run
     ( std::string const& abs_path_to_module
     , std::string const& method
-    , boost::python::list const& locations_and_parameters
+    , boost::python::object const& locations_and_parameters
     , std::string const& output_directory
+    , boost::python::dict const& options
     );
 
   gspc::job_id_t async_run
     ( std::string const& method
-    , boost::python::list const& locations_and_parameters
+    , boost::python::object const& locations_and_parameters
     );
 
+  gspc::job_id_t async_run
+    ( std::string const& method
+    , boost::python::object const& locations_and_parameters
+    , boost::python::dict const& options
+    );
+
+  gspc::job_id_t async_run
+     ( std::string const& method
+     , boost::python::object const& locations_and_parameters
+     , std::string const& output_directory
+     );
+
   gspc::job_id_t async_run
      ( std::string const& method
-     , boost::python::list const& locations_and_parameters
+     , boost::python::object const& locations_and_parameters
      , std::string const& output_directory
+     , boost::python::dict const& options
+     );
+
+  gspc::job_id_t async_run
+     ( std::string const& abs_path_to_module
+     , std::string const& method
+     , boost::python::object const& locations_and_parameters
      );
 
   gspc::job_id_t async_run
      ( std::string const& abs_path_to_module
      , std::string const& method
-     , boost::python::list const& locations_and_parameters
+     , boost::python::object const& locations_and_parameters
+     , boost::python::dict const& options
      );
 
   gspc::job_id_t async_run
      ( std::string const& abs_path_to_module
      , std::string const& method
-     , boost::python::list const& locations_and_parameters
+     , boost::python::object const& locations_and_parameters
      , std::string const& output_directory
      );
 
+  gspc::job_id_t async_run
+     ( std::string const& abs_path_to_module
+     , std::string const& method
+     , boost::python::object const& locations_and_parameters
+     , std::string const& output_directory
+     , boost::python::dict const& options
+     );
+
+  gspc::job_id_t open_job
+    ( std::string const& method
+    , boost::python::dict const& options
+    );
+
+  gspc::job_id_t open_job
+    ( std::string const& abs_path_to_module
+    , std::string const& method
+    , std::string const& output_directory
+    , boost::python::dict const& options
+    );
+
+  void put_parameters
+    ( gspc::job_id_t const& job
+    , boost::python::object const& locations_and_parameters
+    );
+
+  void close_job (gspc::job_id_t const& job);
+
+  boost::python::list cancel (gspc::job_id_t const& job);
+  boost::python::list cancel (gspc::job_id_t const& job, bool interrupt);
+
   boost::python::list collect_results
     (gspc::job_id_t const& job_id);
 
@@ -118,32 +354,107 @@ public:
   unsigned long get_total_number_of_tasks
      (gspc::job_id_t const& job);
 
+  unsigned long get_number_of_workers_with_capability
+    (std::string const& capability);
+
   boost::python::object pop_result (gspc::job_id_t const& job);
 
+  boost::python::list pop_results
+    (gspc::job_id_t const& job, unsigned long max_n);
+
+  boost::python::list pop_results
+    (gspc::job_id_t const& job, unsigned long max_n, double timeout);
+
   void stop_runtime();
 
 private:
-  void add_workers (descriptions_and_entry_points_t const&);
+  void add_workers (std::vector<dart::worker_group> const&);
+  void update_shares();
+  unsigned long initial_max_running_chunks
+    (dart::job_options const&, unsigned long n_chunks);
+  void start_share_updates();
+  void stop_share_updates();
+  void update_number_of_workers();
+  unsigned long number_of_workers();
+
+  dart::worker_group_startup start_worker_group (dart::worker_group const&);
 
   boost::program_options::variables_map get_options
     (boost::python::dict const&);
 
-  std::list<pnet::type::value::value_type> get_location_and_parameters
-    (boost::python::list const& locations_and_parameters);
+  dart::job_options get_job_options (boost::python::dict const&);
 
-  unsigned long get_number_of_tasks
-    (boost::python::list const& locations_and_parameters);
+  std::shared_ptr<dart::job_results> find_job_results
+    (gspc::job_id_t const& job);
+  bool all_results_retrieved (gspc::job_id_t const& job);
 
-  int get_number_of_workers_with_capability
-  	(std::string const& capability);
+  [[noreturn]] void throw_does_not_accept_parameters
+    (gspc::job_id_t const& job);
+
+  pnetc::type::config::config get_config
+    ( std::string const& abs_path_to_module
+    , std::string const& method
+    , std::string const& output_directory
+    , dart::job_options const& job_options
+    );
+
+  unsigned long add_task_chunks
+    ( std::multimap<std::string, pnet::type::value::value_type>& job_input
+    , boost::python::object const& locations_and_parameters
+    , dart::job_options const& job_options
+    , unsigned long first_task_id
+    );
+
+  unsigned long add_task_chunks
+    ( std::multimap<std::string, pnet::type::value::value_type>& job_input
+    , std::string const& location
+    , boost::python::object const& parameters
+    , unsigned long chunksize
+    , unsigned long first_task_id
+    );
+
+  void validate_location (std::string const& location);
 
-  descriptions_and_entry_points_t parse_worker_description_file
+
+  std::vector<dart::worker_group> parse_worker_description_file
     (boost::filesystem::path const& nodefile);
 
   bool known_location (std::string const& location);
 
-  boost::python::object get_next_task_result
-     (gspc::client& client, gspc::job_id_t const& job);
+  //! \note to be called with _workers_mutex locked
+  void index_workers
+    ( gspc::worker_description const& description
+    , std::vector<std::string> const& hosts
+    );
+  void unindex_workers (std::string const& host);
+
+  std::shared_ptr<gspc::client> client();
+
+  std::map<std::string, std::string> remove_all_workers();
+  std::map<std::string, std::string> remove_workers_on
+    (std::vector<std::string> const& hosts);
+
+  void wait_for_task_results
+    ( gspc::job_id_t const& job
+    , dart::job_results& job_results
+    , unsigned long max_n
+    , double timeout
+    );
+
+  void fetch_task_results
+    ( gspc::job_id_t const& job
+    , dart::job_results& job_results
+    , std::string const& request
+    );
+
+  void extract_job_results
+    (gspc::job_id_t const& job, dart::job_results& job_results);
+
+  void resubmit_delayed_retries
+    (gspc::job_id_t const& job, dart::job_results& job_results);
+
+  void speculate_on_stragglers
+    (gspc::job_id_t const& job, dart::job_results& job_results);
 
 private:
   boost::program_options::variables_map _vm;
@@ -152,9 +463,29 @@ private:
   gspc::installation _gspc_installation;
   std::unique_ptr<gspc::scoped_rifd> _master_rifd;
   std::unique_ptr<gspc::scoped_runtime_system> _drts;
+  std::shared_ptr<gspc::client> _client;
+  std::mutex _client_mutex;
   std::vector<std::unique_ptr<gspc::scoped_rifds>> _worker_rifds;
   boost::filesystem::path _python_home;
-  descriptions_and_entry_points_t _descriptions_and_entry_points;
-  std::unordered_map<gspc::job_id_t, std::pair<unsigned long, std::queue<boost::python::object>>> _job_results;
-  boost::uuids::random_generator _generator;
+  std::string _python_library;
+  //! number of started workers per capability (location) and the
+  //! descriptions of the workers started on each host
+  std::unordered_map<std::string, unsigned long> _workers_per_capability;
+  std::unordered_map<std::string, std::vector<gspc::worker_description>>
+    _worker_descriptions_per_host;
+  //! guards _worker_rifds and the worker index
+  std::mutex _workers_mutex;
+  //! serializes adding workers to the runtime system
+  std::mutex _add_worker_mutex;
+  std::unordered_map<gspc::job_id_t, std::shared_ptr<dart::job_results>> _job_results;
+  //! the asynchronous jobs all results of which were popped, for which
+  //! popping returns no results instead of failing as for unknown jobs
+  std::unordered_set<gspc::job_id_t> _retrieved_jobs;
+  std::mutex _job_results_mutex;
+  std::mutex _shares_mutex;
+  //! updates the shares periodically until stopped
+  std::thread _share_updates;
+  std::mutex _share_updates_mutex;
+  std::condition_variable _share_updates_stopped;
+  bool _stop_share_updates {false};
 };
@@ -1,10 +1,11 @@
 #include <cpp/python3_functions.hpp>
 
+#include <we/type/bytearray.hpp>
+
 #include <string>
 #include <utility>
-#include <vector>
 
-std::pair<std::string, std::vector<char>> handle_error()
+std::pair<std::string, we::type::bytearray> handle_error()
 {
   PyObject *pytype, *pyvalue, *pytraceback;
 
@@ -41,8 +42,8 @@ std::pair<std::string, std::vector<char>> handle_error()
     dart::Py_DecRef (outStr);
   }
 
-  std::pair<std::string, std::vector<char>> result
-    {std::move (err_msg), std::vector<char>()};
+  std::pair<std::string, we::type::bytearray> result
+    {std::move (err_msg), we::type::bytearray()};
 
   dart::Py_DecRef (strtype);
   dart::Py_DecRef (pytypestr);
@@ -15,8 +15,13 @@ namespace dart
   typedef void Py_DecRef_t (PyObject*);
   typedef PyObject* PyImport_Import_t (PyObject*);
   typedef PyObject* PyImport_ImportModule_t (const char*);
+  typedef PyObject* PyImport_ReloadModule_t (PyObject*);
   typedef PyObject* PyObject_GetAttrString_t (PyObject*, const char*);
+  typedef int PyObject_SetAttrString_t (PyObject*, const char*, PyObject*);
+  typedef int PyObject_HasAttrString_t (PyObject*, const char*);
   typedef PyObject* PyUnicode_FromString_t (const char*);
+  typedef PyObject* PyUnicode_FromStringAndSize_t (const char*, Py_ssize_t);
+  typedef PyObject* PyBytes_FromStringAndSize_t (const char*, Py_ssize_t);
   typedef PyObject* PyUnicode_AsEncodedString_t (PyObject*, const char*, const char*);
   typedef PyObject* PyUnicode_AsASCIIString_t (PyObject*);
   typedef char* PyBytes_AsString_t (PyObject*);
@@ -29,6 +34,10 @@ namespace dart
   typedef void PyErr_NormalizeException_t (PyObject**, PyObject**, PyObject**);
   typedef void PyErr_Fetch_t (PyObject**, PyObject**, PyObject**);
   typedef void PyErr_Print_t();
+  typedef void PyOS_BeforeFork_t();
+  typedef void PyOS_AfterFork_Parent_t();
+  typedef void PyOS_AfterFork_Child_t();
+  typedef void PyOS_AfterFork_t();
 
   Py_Initialize_t* Py_Initialize (nullptr);
   Py_DecodeLocale_t* Py_DecodeLocale (nullptr);
@@ -40,8 +49,13 @@ namespace dart
   Py_DecRef_t* Py_DecRef (nullptr);
   PyImport_Import_t* PyImport_Import (nullptr);
   PyImport_ImportModule_t* PyImport_ImportModule (nullptr);
+  PyImport_ReloadModule_t* PyImport_ReloadModule (nullptr);
   PyObject_GetAttrString_t* PyObject_GetAttrString (nullptr);
+  PyObject_SetAttrString_t* PyObject_SetAttrString (nullptr);
+  PyObject_HasAttrString_t* PyObject_HasAttrString (nullptr);
   PyUnicode_FromString_t* PyUnicode_FromString (nullptr);
+  PyUnicode_FromStringAndSize_t* PyUnicode_FromStringAndSize (nullptr);
+  PyBytes_FromStringAndSize_t* PyBytes_FromStringAndSize (nullptr);
   PyUnicode_AsEncodedString_t* PyUnicode_AsEncodedString (nullptr);
   PyUnicode_AsASCIIString_t* PyUnicode_AsASCIIString (nullptr);
   PyBytes_AsString_t* PyBytes_AsString (nullptr);
@@ -54,4 +68,8 @@ namespace dart
   PyErr_NormalizeException_t* PyErr_NormalizeException (nullptr);
   PyErr_Fetch_t* PyErr_Fetch (nullptr);
   PyErr_Print_t* PyErr_Print (nullptr);
+  PyOS_BeforeFork_t* PyOS_BeforeFork (nullptr);
+  PyOS_AfterFork_Parent_t* PyOS_AfterFork_Parent (nullptr);
+  PyOS_AfterFork_Child_t* PyOS_AfterFork_Child (nullptr);
+  PyOS_AfterFork_t* PyOS_AfterFork (nullptr);
 }
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Python.h>
+
+#include <utility>
+
+namespace dart
+{
+  //! \note releases the global interpreter lock for the lifetime of the
+  //! object, such that other python threads run while the runtime system
+  //! is blocking. Does nothing when the calling thread does not hold the
+  //! lock, e.g. when nested into another release.
+  class scoped_gil_release
+  {
+  public:
+    scoped_gil_release()
+      : _state (PyGILState_Check() ? PyEval_SaveThread() : nullptr)
+    {}
+
+    ~scoped_gil_release()
+    {
+      if (_state)
+      {
+        PyEval_RestoreThread (_state);
+      }
+    }
+
+    scoped_gil_release (scoped_gil_release const&) = delete;
+    scoped_gil_release& operator= (scoped_gil_release const&) = delete;
+
+  private:
+    PyThreadState* _state;
+  };
+
+  //! \note no python objects must be touched by fun
+  template<typename Fun>
+    auto without_gil (Fun&& fun) -> decltype (fun())
+  {
+    scoped_gil_release const release;
+
+    return std::forward<Fun> (fun)();
+  }
+}
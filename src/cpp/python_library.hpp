@@ -0,0 +1,93 @@
+#pragma once
+
+#include <boost/filesystem.hpp>
+
+#include <map>
+#include <string>
+#include <utility>
+
+namespace dart
+{
+  std::string find_python_library (std::string const& python_home)
+  {
+    boost::filesystem::recursive_directory_iterator endit;
+
+    for ( boost::filesystem::recursive_directory_iterator it (python_home + "/lib")
+        ; it != endit
+        ; ++it
+        )
+    {
+      if ( boost::filesystem::is_regular_file (*it)
+         && it->path().extension() == ".so"
+         && (it->path().stem().string().find ("libpython") != std::string::npos)
+         )
+      {
+        return it->path().string();
+      }
+    }
+
+    return {};
+  }
+
+  //! \note returns an error message (empty on success) and the shared
+  //! python library to use: either the given one or the first one found
+  //! under python_home/lib. Successful lookups are cached for the
+  //! lifetime of the worker process, failed ones are retried.
+  std::pair<std::string, std::string> locate_python_library
+    ( std::string const& python_home
+    , std::string const& python_library
+    , std::string const& host
+    )
+  {
+    static std::map<std::pair<std::string, std::string>, std::string> located;
+
+    auto const key (std::make_pair (python_home, python_library));
+    auto const it (located.find (key));
+
+    if (it != located.end())
+    {
+      return {std::string(), it->second};
+    }
+
+    if (!boost::filesystem::exists (python_home))
+    {
+      return { "The folder \"" + python_home + "\" does not exist on the host " + host
+             , std::string()
+             };
+    }
+
+    std::string library (python_library);
+
+    if (!library.empty())
+    {
+      if (!boost::filesystem::exists (library))
+      {
+        return { "The python library \"" + library + "\" does not exist on the host " + host
+               , std::string()
+               };
+      }
+    }
+    else
+    {
+      if (!boost::filesystem::exists (python_home + "/lib"))
+      {
+        return { "The folder \"" + python_home + "/lib\" does not exist on the host " + host
+               , std::string()
+               };
+      }
+
+      library = find_python_library (python_home);
+
+      if (library.empty())
+      {
+        return { "No shared python library was found in the folder " + python_home + "/lib on the host " + host
+               , std::string()
+               };
+      }
+    }
+
+    located.emplace (key, library);
+
+    return {std::string(), library};
+  }
+}
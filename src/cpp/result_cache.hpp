@@ -0,0 +1,138 @@
+#pragma once
+
+#include <we/type/bytearray.hpp>
+
+#include <boost/filesystem.hpp>
+#include <boost/optional.hpp>
+#include <boost/uuid/name_generator.hpp>
+#include <boost/uuid/nil_generator.hpp>
+#include <boost/uuid/uuid.hpp>
+#include <boost/uuid/uuid_io.hpp>
+
+#include <fstream>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace dart
+{
+  //! \note results of succeeded tasks, stored as one file per task in a
+  //! (node local or shared) directory. The file name is a SHA-1 based
+  //! hash of the module source, the method and the parameters, such that
+  //! the results of a changed module are never returned. The hash is
+  //! computed by name_generator, which is SHA-1 based also in Boost 1.61,
+  //! unlike name_generator_sha1, which requires Boost 1.66.
+  class result_cache
+  {
+  public:
+    result_cache
+        ( std::string const& directory
+        , std::string const& module_source
+        , std::string const& method
+        )
+      : _directory (directory)
+      , _method_key
+          ( boost::uuids::name_generator
+              ( boost::uuids::name_generator (boost::uuids::nil_uuid())
+                  (module_source.data(), module_source.size())
+              )
+              (method.data(), method.size())
+          )
+    {}
+
+    //! \note the cache of the given module file, none if the module
+    //! source can not be read
+    static boost::optional<result_cache> for_module
+      ( std::string const& directory
+      , std::string const& path_to_python_module
+      , std::string const& module
+      , std::string const& method
+      )
+    {
+      std::ifstream source
+        ( ( boost::filesystem::path (path_to_python_module)
+          / (module + ".py")
+          ).string()
+        , std::ios::binary
+        );
+
+      if (!source)
+      {
+        return boost::none;
+      }
+
+      std::ostringstream module_source;
+      module_source << source.rdbuf();
+
+      return result_cache (directory, module_source.str(), method);
+    }
+
+    std::string key
+      (we::type::bytearray const& parameters, bool binary_parameters) const
+    {
+      char const kind (binary_parameters ? 'b' : 's');
+      std::vector<char> const& bytes (parameters.v());
+
+      return boost::uuids::to_string
+        ( boost::uuids::name_generator
+            (boost::uuids::name_generator (_method_key) (&kind, 1))
+            (bytes.data(), bytes.size())
+        );
+    }
+
+    boost::optional<we::type::bytearray> lookup (std::string const& key) const
+    {
+      std::ifstream file ((_directory / key).string(), std::ios::binary);
+
+      if (!file)
+      {
+        return boost::none;
+      }
+
+      std::vector<char> const result
+        ( (std::istreambuf_iterator<char> (file))
+        , std::istreambuf_iterator<char>()
+        );
+
+      return we::type::bytearray (result);
+    }
+
+    //! \note best effort: a result that can not be stored is computed
+    //! again. The file is written under a unique name and renamed, such
+    //! that concurrent workers never read partially written results.
+    void store (std::string const& key, we::type::bytearray const& result) const
+    {
+      boost::system::error_code error;
+
+      boost::filesystem::create_directories (_directory, error);
+
+      boost::filesystem::path const temporary
+        (_directory / boost::filesystem::unique_path (key + ".%%%%-%%%%-%%%%"));
+
+      {
+        std::ofstream file (temporary.string(), std::ios::binary);
+        std::vector<char> const& bytes (result.v());
+
+        if (!file.write (bytes.data(), bytes.size()).flush())
+        {
+          file.close();
+          boost::filesystem::remove (temporary, error);
+
+          return;
+        }
+      }
+
+      boost::filesystem::rename (temporary, _directory / key, error);
+
+      if (error)
+      {
+        boost::filesystem::remove (temporary, error);
+      }
+    }
+
+  private:
+    boost::filesystem::path _directory;
+    boost::uuids::uuid _method_key;
+  };
+}
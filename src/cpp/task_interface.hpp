@@ -3,8 +3,22 @@
 #include <cpp/handle_error.hpp>
 
 #include <dlfcn.h>
+#include <poll.h>
+#include <signal.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
 #include <fstream>
 #include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 void last_dl_error_msg (std::string* pError)
 {
@@ -81,147 +95,796 @@ bool load_symbols (void* pLib, std::string* pError)
   LOAD_PYTHON_SYMBOL (PyUnicode_AsASCIIString)
   LOAD_PYTHON_SYMBOL (PyErr_Print)
   LOAD_PYTHON_SYMBOL (Py_BuildValue)
+  LOAD_PYTHON_SYMBOL (PyImport_ReloadModule)
+  LOAD_PYTHON_SYMBOL (PyObject_SetAttrString)
+  LOAD_PYTHON_SYMBOL (PyObject_HasAttrString)
+  LOAD_PYTHON_SYMBOL (PyUnicode_FromStringAndSize)
+  LOAD_PYTHON_SYMBOL (PyBytes_FromStringAndSize)
 
   return true;
 }
 
-std::pair<std::string, std::vector<char>> run_python_task
+//! \note the fork hooks are resolved by the first task with a timeout
+//! only, from the already loaded libpython. Before Python 3.7 there is
+//! neither PyOS_BeforeFork nor PyOS_AfterFork_Parent, and the child
+//! calls PyOS_AfterFork instead of PyOS_AfterFork_Child
+bool load_fork_symbols (std::string* pError)
+{
+  if (dart::PyOS_AfterFork_Child || dart::PyOS_AfterFork)
+  {
+    return true;
+  }
+
+  dart::PyOS_BeforeFork = (dart::PyOS_BeforeFork_t*)
+    ::dlsym (RTLD_DEFAULT, "PyOS_BeforeFork");
+  dart::PyOS_AfterFork_Parent = (dart::PyOS_AfterFork_Parent_t*)
+    ::dlsym (RTLD_DEFAULT, "PyOS_AfterFork_Parent");
+  dart::PyOS_AfterFork_Child = (dart::PyOS_AfterFork_Child_t*)
+    ::dlsym (RTLD_DEFAULT, "PyOS_AfterFork_Child");
+
+  if (dart::PyOS_AfterFork_Child)
+  {
+    return true;
+  }
+
+  dart::PyOS_AfterFork = (dart::PyOS_AfterFork_t*)
+    ::dlsym (RTLD_DEFAULT, "PyOS_AfterFork");
+
+  if (dart::PyOS_AfterFork == NULL)
+  {
+    last_dl_error_msg (pError);
+    *pError = "Error: " + *pError;
+    return false;
+  }
+
+  return true;
+}
+
+namespace dart
+{
+  //! \note the beginning of the error of tasks that exceeded their timeout
+  constexpr char const* task_timeout_error = "TimeoutError:";
+
+  //! \note a worker process keeps one interpreter alive for all its
+  //! tasks: libpython is loaded and initialized by the first task only,
+  //! imported modules and callables are cached and re-imported only
+  //! when the module file has changed on disk. Modules are loaded from
+  //! their file under a name unique per file, such that modules of the
+  //! same name in different directories do not replace each other in
+  //! sys.modules
+  class python_context
+  {
+  public:
+    bool initialize
+      ( std::string const& python_home
+      , std::string const& python_library
+      , std::string* pError
+      )
+    {
+      if (_pLib != nullptr)
+      {
+        return true;
+      }
+
+      void* pLib (nullptr);
+
+      if (!load_library (python_library, &pLib, pError))
+      {
+        *pError = "Could not open  the library \""
+                + python_library
+                + "\": "
+                + *pError;
+        return false;
+      }
+
+      if (!load_symbols (pLib, pError))
+      {
+        return false;
+      }
+
+      //! \note the interpreter keeps a pointer to the python home
+      wchar_t* pyhome = dart::Py_DecodeLocale (python_home.c_str(), NULL);
+
+      dart::Py_SetPythonHome (pyhome);
+      dart::Py_Initialize();
+
+      dart::PyRun_SimpleStringFlags ("import sys", NULL);
+      dart::PyRun_SimpleStringFlags
+        ( "def _dart_load_module (name, path):\n"
+          "  import importlib.util\n"
+          "  spec = importlib.util.spec_from_file_location (name, path)\n"
+          "  module = importlib.util.module_from_spec (spec)\n"
+          "  sys.modules[name] = module\n"
+          "  try:\n"
+          "    spec.loader.exec_module (module)\n"
+          "  except BaseException:\n"
+          "    del sys.modules[name]\n"
+          "    raise\n"
+          "  return module\n"
+        , NULL
+        );
+
+      _pLib = pLib;
+
+      return true;
+    }
+
+    //! \note returns borrowed references to the callable and to its
+    //! module, or NULL with the python error indicator set unless the
+    //! attribute exists but is not callable
+    PyObject* callable
+      ( std::string const& path_to_python_module
+      , std::string const& module
+      , std::string const& method
+      , PyObject** ppModule
+      )
+    {
+      cached_module* cached (this->module (path_to_python_module, module));
+
+      if (cached == nullptr)
+      {
+        return NULL;
+      }
+
+      *ppModule = cached->module;
+
+      auto const it (cached->functions.find (method));
+
+      if (it != cached->functions.end())
+      {
+        return it->second;
+      }
+
+      PyObject* pFunc (dart::PyObject_GetAttrString (cached->module, method.c_str()));
+
+      if (pFunc == NULL)
+      {
+        return NULL;
+      }
+
+      if (!dart::PyCallable_Check (pFunc))
+      {
+        dart::Py_DecRef (pFunc);
+        return NULL;
+      }
+
+      return cached->functions.emplace (method, pFunc).first->second;
+    }
+
+  private:
+    //! \note the modification time in nanoseconds and the size, as the
+    //! time alone misses changes within its resolution
+    struct file_version
+    {
+      std::time_t seconds;
+      long nanoseconds;
+      off_t size;
+
+      bool operator== (file_version const& other) const
+      {
+        return seconds == other.seconds
+          && nanoseconds == other.nanoseconds
+          && size == other.size;
+      }
+    };
+
+    struct cached_module
+    {
+      PyObject* module;
+      file_version version;
+      std::unordered_map<std::string, PyObject*> functions;
+    };
+
+    cached_module* module
+      ( std::string const& path_to_python_module
+      , std::string const& module
+      )
+    {
+      add_to_sys_path (path_to_python_module);
+
+      std::string const file (path_to_python_module + "/" + module + ".py");
+      file_version const version (module_version (file));
+
+      auto it (_modules.find (file));
+
+      if (it != _modules.end() && it->second.version == version)
+      {
+        return &it->second;
+      }
+
+      if (it != _modules.end())
+      {
+        release (it->second);
+        _modules.erase (it);
+      }
+
+      auto const name
+        ( _module_names.emplace
+            (file, module + "__dart_" + std::to_string (_module_names.size()))
+          .first->second
+        );
+
+      PyObject* pModule (load_module (name, file));
+
+      if (pModule == NULL)
+      {
+        return nullptr;
+      }
+
+      return &_modules.emplace
+        (file, cached_module {pModule, version, {}}).first->second;
+    }
+
+    //! \note returns a new reference to the module executed from the
+    //! file, or NULL with the python error indicator set
+    static PyObject* load_module (std::string const& name, std::string const& file)
+    {
+      PyObject* pMain (dart::PyImport_ImportModule ("__main__"));
+
+      if (pMain == NULL)
+      {
+        return NULL;
+      }
+
+      PyObject* pLoad (dart::PyObject_GetAttrString (pMain, "_dart_load_module"));
+      dart::Py_DecRef (pMain);
+
+      if (pLoad == NULL)
+      {
+        return NULL;
+      }
+
+      PyObject* pName (dart::PyUnicode_FromString (name.c_str()));
+      PyObject* pFile (dart::PyUnicode_FromString (file.c_str()));
+
+      PyObject* pModule
+        ( pName == NULL || pFile == NULL
+        ? NULL
+        : dart::PyObject_CallFunctionObjArgs (pLoad, pName, pFile, NULL)
+        );
+
+      // Py_DecRef ignores NULL
+      dart::Py_DecRef (pFile);
+      dart::Py_DecRef (pName);
+      dart::Py_DecRef (pLoad);
+
+      return pModule;
+    }
+
+    static file_version module_version (std::string const& file)
+    {
+      struct stat info;
+
+      if (::stat (file.c_str(), &info) != 0)
+      {
+        return file_version {0, 0, 0};
+      }
+
+      return file_version {info.st_mtim.tv_sec, info.st_mtim.tv_nsec, info.st_size};
+    }
+
+    static void release (cached_module const& cached)
+    {
+      for (auto const& function : cached.functions)
+      {
+        dart::Py_DecRef (function.second);
+      }
+
+      dart::Py_DecRef (cached.module);
+    }
+
+    void add_to_sys_path (std::string const& path_to_python_module)
+    {
+      if (!_sys_paths.emplace (path_to_python_module).second)
+      {
+        return;
+      }
+
+      std::ostringstream osstr;
+      osstr << "sys.path.append ('" << path_to_python_module << "')";
+      dart::PyRun_SimpleStringFlags (osstr.str().c_str(), NULL);
+    }
+
+    void* _pLib {nullptr};
+    std::unordered_set<std::string> _sys_paths;
+    //! keyed by the path of the module file
+    std::unordered_map<std::string, cached_module> _modules;
+    std::unordered_map<std::string, std::string> _module_names;
+  };
+
+  python_context& worker_python_context()
+  {
+    static python_context context;
+    return context;
+  }
+}
+
+namespace
+{
+  //! \note returns the captured text and resets the capture, such that
+  //! the next task does not report it again
+  std::string take_captured_output (PyObject* pModule, const char* name)
+  {
+    if (!dart::PyObject_HasAttrString (pModule, name))
+    {
+      return {};
+    }
+
+    PyObject* catcher = dart::PyObject_GetAttrString (pModule, name);
+
+    PyObject* output = dart::PyObject_GetAttrString (catcher, "value");
+    PyObject* pyStr = dart::PyUnicode_AsEncodedString (output, "utf-8","Error ~");
+
+    std::string captured (dart::PyBytes_AsString (pyStr));
+
+    PyObject* empty = dart::PyUnicode_FromString ("");
+    dart::PyObject_SetAttrString (catcher, "value", empty);
+
+    dart::Py_DecRef (empty);
+    dart::Py_DecRef (output);
+    dart::Py_DecRef (pyStr);
+    dart::Py_DecRef (catcher);
+
+    return captured;
+  }
+
+  //! \note initializes the interpreter and imports the module, returns
+  //! the error if the method can not be called
+  std::string load_python_method
+    ( std::string const& python_home
+    , std::string const& python_library
+    , std::string const& path_to_python_module
+    , std::string const& module
+    , std::string const& method
+    , PyObject** ppFunc
+    , PyObject** ppModule
+    )
+  {
+    std::string error;
+    dart::python_context& context (dart::worker_python_context());
+
+    if (!context.initialize (python_home, python_library, &error))
+    {
+      return error;
+    }
+
+    *ppFunc = context.callable (path_to_python_module, module, method, ppModule);
+
+    if (*ppFunc == NULL)
+    {
+      if (dart::PyErr_Occurred())
+      {
+        return handle_error().first;
+      }
+
+      return "The attribute \"" + method + "\" of the module \"" + module
+        + "\" is not callable";
+    }
+
+    return error;
+  }
+}
+
+std::pair<std::string, we::type::bytearray> run_python_task
   ( std::string const& python_home
   , std::string const& python_library
   , std::string const& path_to_python_module
   , std::string const& module
   , std::string const& method
-  , std::string const& method_params
+  , we::type::bytearray const& method_params
+  , bool binary_params
   , std::string const& //worker
   , std::string const& log_file
   )
 {
-  void* pLib (nullptr);
-  std::string error;
-
-  if (!load_library (python_library, &pLib, &error))
+  PyObject* pModule (nullptr);
+  PyObject* pFunc (nullptr);
+
+  std::string const error
+    ( load_python_method
+        ( python_home
+        , python_library
+        , path_to_python_module
+        , module
+        , method
+        , &pFunc
+        , &pModule
+        )
+    );
+
+  if (!error.empty())
   {
-    std::string err_msg ("Could not open  the library \""
-			            + python_library
-			            + "\": "
-			            + error
-			            );
-    return std::make_pair (err_msg, std::vector<char>());
+    return std::make_pair (error, we::type::bytearray());
   }
 
-  if (!load_symbols (pLib, &error))
+  std::vector<char> const& param_bytes (method_params.v());
+
+  PyObject* params
+    ( binary_params
+    ? dart::PyBytes_FromStringAndSize (param_bytes.data(), param_bytes.size())
+    : dart::PyUnicode_FromStringAndSize (param_bytes.data(), param_bytes.size())
+    );
+
+  if (params == NULL)
   {
-    return std::make_pair (error, std::vector<char>());
+    return handle_error();
   }
 
-  PyObject *pModule, *pFunc;
+  std::ofstream ofslog (log_file.c_str(), std::ofstream::app);
+  ofslog << std::endl;
+
+  PyObject* res (dart::PyObject_CallFunctionObjArgs (pFunc, params, NULL));
+  dart::Py_DecRef (params);
+
+  if (!res)
+  {
+    std::string err_msg;
+
+    if (dart::PyErr_Occurred())
+    {
+      err_msg = handle_error().first;
+    }
+
+    if (dart::PyObject_HasAttrString (pModule, "catch_stderr"))
+    {
+      dart::PyErr_Print();
 
-  wchar_t *pyhome = dart::Py_DecodeLocale (python_home.c_str(), NULL);
+      err_msg += take_captured_output (pModule, "catch_stderr");
+    }
 
-  dart::Py_SetPythonHome (pyhome);
-  dart::Py_Initialize();
+    ofslog << "Error: " << err_msg << std::endl;
 
-  dart::PyRun_SimpleStringFlags ("import sys", NULL);
+    return std::make_pair (err_msg, we::type::bytearray());
+  }
 
-  std::ostringstream osstr;
-  osstr << "sys.path.append ('" << path_to_python_module << "')";
-  dart::PyRun_SimpleStringFlags (osstr.str().c_str(), NULL);
+  std::string const logging_info (take_captured_output (pModule, "catch_stdout"));
+  if (!logging_info.empty())
+  {
+    ofslog << "Logging info: \n" << logging_info << std::endl;
+  }
 
-  pModule = dart::PyImport_ImportModule (module.c_str());
- 
-  if (pModule != NULL)
+  Py_buffer view;
+  if (dart::PyObject_GetBuffer (res, &view, PyBUF_C_CONTIGUOUS | PyBUF_SIMPLE) < 0)
   {
-    pFunc = dart::PyObject_GetAttrString(pModule, method.c_str());
+    dart::Py_DecRef (res);
+    return handle_error();
+  }
+
+  we::type::bytearray pyres (static_cast<char const*> (view.buf), view.len);
 
-    if (pFunc && dart::PyCallable_Check (pFunc))
+  dart::PyBuffer_Release (&view);
+  dart::Py_DecRef (res);
+
+  return std::make_pair (std::string(), std::move (pyres));
+}
+
+namespace
+{
+  bool write_all (int fd, char const* data, std::size_t size)
+  {
+    while (size > 0)
     {
-      PyObject* params = dart::PyUnicode_FromString (method_params.c_str());
+      ssize_t const written (::write (fd, data, size));
 
-      std::ofstream ofslog (log_file.c_str(), std::ofstream::app);
-      ofslog << std::endl;
+      if (written < 0 && errno != EINTR)
+      {
+        return false;
+      }
 
-      PyObject* res (dart::PyObject_CallFunctionObjArgs (pFunc, params, NULL));
-      if (!res)
+      if (written > 0)
       {
-        std::string err_msg;
+        data += written;
+        size -= written;
+      }
+    }
 
-        if (dart::PyErr_Occurred())
-        {
-          err_msg = handle_error().first;
-        }
+    return true;
+  }
 
-        PyObject* catch_err = dart::PyObject_GetAttrString (pModule,"catch_stderr");
+  bool write_field (int fd, std::vector<char> const& bytes)
+  {
+    std::uint64_t const size (bytes.size());
 
-        if (catch_err)
-        {
-          dart::PyErr_Print();
+    return write_all (fd, reinterpret_cast<char const*> (&size), sizeof (size))
+      && write_all (fd, bytes.data(), bytes.size());
+  }
 
-          PyObject* output = dart::PyObject_GetAttrString (catch_err,"value");
-          PyObject* pyStr = dart::PyUnicode_AsEncodedString (output, "utf-8","Error ~");
+  bool read_field
+    (std::vector<char> const& message, std::size_t* pos, std::vector<char>* field)
+  {
+    std::uint64_t size;
 
-          err_msg += (dart::PyBytes_AsString (pyStr));
+    if (message.size() - *pos < sizeof (size))
+    {
+      return false;
+    }
 
-          dart::Py_DecRef (output);
-          dart::Py_DecRef (pyStr);
-          dart::Py_DecRef (catch_err);
-          dart::Py_DecRef (params);
-          dart::Py_DecRef (pFunc);
-          dart::Py_DecRef (pModule);
-        }
+    std::memcpy (&size, message.data() + *pos, sizeof (size));
+    *pos += sizeof (size);
 
-        ofslog << "Error: " << err_msg << std::endl;
+    if (message.size() - *pos < size)
+    {
+      return false;
+    }
+
+    field->assign (message.data() + *pos, message.data() + *pos + size);
+    *pos += size;
+
+    return true;
+  }
+
+  enum class read_outcome
+  {
+    end_of_file,
+    deadline,
+    error,
+  };
+
+  //! \note reads until the end of file, unless the deadline is reached
+  //! before or polling or reading fails (errno is left as set by it)
+  read_outcome read_until
+    ( int fd
+    , std::chrono::steady_clock::time_point deadline
+    , std::vector<char>* message
+    )
+  {
+    char buffer[1 << 16];
 
-        return std::make_pair (err_msg, std::vector<char>());
+    for (;;)
+    {
+      auto const remaining
+        ( std::chrono::duration_cast<std::chrono::milliseconds>
+            (deadline - std::chrono::steady_clock::now())
+        . count()
+        );
+
+      if (remaining <= 0)
+      {
+        return read_outcome::deadline;
+      }
+
+      pollfd descriptor {fd, POLLIN, 0};
+
+      int const ready (::poll (&descriptor, 1, remaining));
+
+      if (ready < 0 && errno != EINTR)
+      {
+        return read_outcome::error;
       }
 
-      PyObject* catch_out = dart::PyObject_GetAttrString (pModule,"catch_stdout");
-      if (catch_out)
+      if (ready <= 0)
       {
-        PyObject* output = dart::PyObject_GetAttrString (catch_out,"value");
-        PyObject* pyStr = dart::PyUnicode_AsEncodedString (output, "utf-8","Error ~");
+        continue;
+      }
 
-        std::ostringstream osstr;
-        osstr << dart::PyBytes_AsString (pyStr);
-        if (!osstr.str().empty())
-        {
-          ofslog << "Logging info: \n" << osstr.str() << std::endl;
-        }
+      ssize_t const n (::read (fd, buffer, sizeof (buffer)));
 
-        dart::Py_DecRef (output);
-        dart::Py_DecRef (pyStr);
-        dart::Py_DecRef (catch_out);
+      if (n < 0 && errno == EINTR)
+      {
+        continue;
       }
 
-      Py_buffer view;
-      if (dart::PyObject_GetBuffer (res, &view, PyBUF_C_CONTIGUOUS | PyBUF_SIMPLE) < 0)
+      if (n < 0)
       {
-        return handle_error();
+        return read_outcome::error;
       }
 
-      std::vector<char> pyres ((char*)view.buf, (char*)view.buf + view.len);
+      if (n == 0)
+      {
+        return read_outcome::end_of_file;
+      }
 
-      dart::PyBuffer_Release (&view);
-      dart::Py_DecRef (res);
+      message->insert (message->end(), buffer, buffer + n);
+    }
+  }
+}
 
-      dart::Py_DecRef (pFunc);
-      dart::Py_DecRef (pModule);
+//! \note executes the method in a child process of the worker, which is
+//! killed when the task has not finished within timeout seconds. The
+//! module is imported by the worker before, such that the child
+//! inherits the interpreter with the imported module and the worker
+//! keeps its interpreter, whatever the task does. A timeout of 0
+//! executes the method in the worker itself.
+std::pair<std::string, we::type::bytearray> run_python_task
+  ( std::string const& python_home
+  , std::string const& python_library
+  , std::string const& path_to_python_module
+  , std::string const& module
+  , std::string const& method
+  , we::type::bytearray const& method_params
+  , bool binary_params
+  , std::string const& worker
+  , std::string const& log_file
+  , double timeout
+  )
+{
+  if (!(timeout > 0))
+  {
+    return run_python_task
+      ( python_home
+      , python_library
+      , path_to_python_module
+      , module
+      , method
+      , method_params
+      , binary_params
+      , worker
+      , log_file
+      );
+  }
+
+  PyObject* pModule (nullptr);
+  PyObject* pFunc (nullptr);
+
+  std::string const error
+    ( load_python_method
+        ( python_home
+        , python_library
+        , path_to_python_module
+        , module
+        , method
+        , &pFunc
+        , &pModule
+        )
+    );
+
+  if (!error.empty())
+  {
+    return std::make_pair (error, we::type::bytearray());
+  }
+
+  int fds[2];
+
+  if (::pipe (fds) != 0)
+  {
+    return std::make_pair
+      ( "Could not create a pipe: " + std::string (std::strerror (errno))
+      , we::type::bytearray()
+      );
+  }
+
+  auto const deadline
+    ( std::chrono::steady_clock::now()
+    + std::chrono::duration_cast<std::chrono::steady_clock::duration>
+        (std::chrono::duration<double> (timeout))
+    );
 
-      return std::make_pair ("", pyres);
+  {
+    std::string error;
+
+    if (!load_fork_symbols (&error))
+    {
+      ::close (fds[0]);
+      ::close (fds[1]);
+
+      return std::make_pair (error, we::type::bytearray());
+    }
+  }
+
+  if (dart::PyOS_BeforeFork)
+  {
+    dart::PyOS_BeforeFork();
+  }
+
+  pid_t const pid (::fork());
+
+  if (pid == 0)
+  {
+    if (dart::PyOS_AfterFork_Child)
+    {
+      dart::PyOS_AfterFork_Child();
     }
     else
     {
-      dart::Py_DecRef(pFunc);
-      dart::Py_DecRef(pModule);
-
-      return handle_error();
+      dart::PyOS_AfterFork();
     }
+    ::close (fds[0]);
+
+    auto const result
+      ( run_python_task
+          ( python_home
+          , python_library
+          , path_to_python_module
+          , module
+          , method
+          , method_params
+          , binary_params
+          , worker
+          , log_file
+          )
+      );
+
+    std::vector<char> const error_bytes (result.first.begin(), result.first.end());
+
+    bool const sent
+      ( write_field (fds[1], error_bytes)
+      && write_field (fds[1], result.second.v())
+      );
+
+    ::_exit (sent ? 0 : 1);
   }
-  else
+
+  if (dart::PyOS_AfterFork_Parent)
   {
-    return handle_error();
+    dart::PyOS_AfterFork_Parent();
+  }
+  ::close (fds[1]);
+
+  if (pid < 0)
+  {
+    ::close (fds[0]);
+
+    return std::make_pair
+      ( "Could not start the task process: " + std::string (std::strerror (errno))
+      , we::type::bytearray()
+      );
   }
 
-  close_library (pLib, &error);
+  std::vector<char> message;
+  read_outcome const outcome (read_until (fds[0], deadline, &message));
+  int const read_error (errno);
+
+  ::close (fds[0]);
+
+  // the child is not waited for unless it has sent its result, as it
+  // might never finish otherwise
+  if (outcome != read_outcome::end_of_file)
+  {
+    ::kill (pid, SIGKILL);
+  }
+
+  int status (0);
+
+  while (::waitpid (pid, &status, 0) < 0 && errno == EINTR)
+  {}
+
+  if (outcome != read_outcome::end_of_file)
+  {
+    std::ostringstream err_msg;
+
+    if (outcome == read_outcome::deadline)
+    {
+      err_msg << dart::task_timeout_error
+              << " the task did not finish within " << timeout << " seconds";
+    }
+    else
+    {
+      err_msg << "Could not read the result of the task process: "
+              << std::strerror (read_error);
+    }
+
+    std::ofstream (log_file.c_str(), std::ofstream::app)
+      << std::endl << "Error: " << err_msg.str() << std::endl;
+
+    return std::make_pair (err_msg.str(), we::type::bytearray());
+  }
+
+  std::size_t pos (0);
+  std::vector<char> error_bytes;
+  std::vector<char> result_bytes;
+
+  if ( !WIFEXITED (status) || WEXITSTATUS (status) != 0
+     || !read_field (message, &pos, &error_bytes)
+     || !read_field (message, &pos, &result_bytes)
+     )
+  {
+    std::ostringstream err_msg;
+    err_msg << "The task process ";
+
+    if (WIFSIGNALED (status))
+    {
+      err_msg << "was terminated by signal " << WTERMSIG (status);
+    }
+    else
+    {
+      err_msg << "exited without a result";
+    }
+
+    return std::make_pair (err_msg.str(), we::type::bytearray());
+  }
 
-  return {};
+  return std::make_pair
+    ( std::string (error_bytes.begin(), error_bytes.end())
+    , we::type::bytearray (result_bytes)
+    );
 }
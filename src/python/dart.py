@@ -1,4 +1,3 @@
-import binascii
 from collections import Counter
 from functools import reduce
 import json
@@ -24,7 +23,53 @@ class catch_stdout:
     self.value += txt
 catch_stdout = catch_stdout()
 
-from DART import runtime
+from DART import JobAborted, runtime
+
+class task_result:
+  """The result of a task. Fields that do not apply (error for succeeded
+  and result for failed tasks) are missing when accessed like a dict."""
+  __slots__ = ( 'task_id', 'location', 'host', 'worker', 'start_time'
+              , 'duration', 'cache_hit', 'error', 'result'
+              )
+
+  def __init__ (self, task_id, location, host, worker, start_time, duration, cache_hit, error, result):
+    self.task_id = task_id
+    self.location = location
+    self.host = host
+    self.worker = worker
+    self.start_time = start_time
+    self.duration = duration
+    self.cache_hit = cache_hit
+    self.error = error
+    self.result = result
+
+  def _missing (self):
+    return 'result' if self.error is not None else 'error'
+
+  def keys (self):
+    return [key for key in self.__slots__ if key != self._missing()]
+
+  def __contains__ (self, key):
+    return key in self.__slots__ and key != self._missing()
+
+  def __getitem__ (self, key):
+    if key not in self:
+      raise KeyError (key)
+    return getattr (self, key)
+
+  def __setitem__ (self, key, value):
+    if key not in self.__slots__:
+      raise KeyError (key)
+    setattr (self, key, value)
+
+  def __repr__ (self):
+    return repr ({key: self[key] for key in self.keys()})
+
+def list_node_local_files (_params):
+  """The task of prepare_local_parameters: the paths of the files in a
+  directory of the host executing it."""
+  path = eval (_params)['path']
+  return dart_context.pack ([os.path.join (path, file) for file in os.listdir (path)])
 
 class dart_context (runtime):
   def __init__(self, python_home, monitor_url = '/var/tmp', **kwargs):
@@ -38,11 +83,11 @@ class dart_context (runtime):
     if (url.scheme == 'http'):
       try:
         request = requests.get (monitor_url)
-      except:
+      except requests.exceptions.RequestException:
         print ('No monitoring database found at ' + monitor_url + '!')
         sys.exit (1);
 
-    self.results = self.results (self.pop_result, self.collect_results, monitor_url, job_name)
+    self.results = self.results (self.pop_result, self.pop_results, self.collect_results, monitor_url, job_name)
     signal.signal (signal.SIGTERM, self.on_exit) # term
     signal.signal (signal.SIGABRT, self.on_exit) # abort
     signal.signal (signal.SIGINT, self.on_exit)  # keyboard interrupt
@@ -51,9 +96,29 @@ class dart_context (runtime):
   def on_exit (self, signum, handler):
     try:
       self.stop()
-      sys.exit (signum)
-    except:
+    except Exception:
       os._exit (2)
+    sys.exit (signum)
+
+  def run (self, *args, **options):
+    try:
+      return self.results.extract (super (dart_context, self).run (*args, options))
+    except JobAborted as aborted:
+      aborted.results = self.results.extract (aborted.results)
+      raise
+
+  def async_run (self, *args, **options):
+    return super (dart_context, self).async_run (*args, options)
+
+  def open_job (self, *args, **options):
+    return super (dart_context, self).open_job (*args, options)
+
+  def cancel (self, job, interrupt = False):
+    results = self.results.extract (super (dart_context, self).cancel (job, interrupt))
+    for result in results:
+      self.results.write_monitoring_info (job, result)
+
+    return results
 
   @staticmethod
   def catch_out():
@@ -65,11 +130,11 @@ class dart_context (runtime):
 
   @staticmethod
   def pack (results):
-    return binascii.b2a_base64 (pickle.dumps (results))
+    return pickle.dumps (results, pickle.HIGHEST_PROTOCOL)
 
   @staticmethod
   def unpack (results):
-    return pickle.loads (binascii.a2b_base64 (results))
+    return pickle.loads (results)
 
   def prepare_parameters (self, base_url, path = '', config = {}):
     url = urlparse (base_url)
@@ -94,15 +159,41 @@ class dart_context (runtime):
 
     return parameters
 
+  def prepare_local_parameters (self, host_paths, config = {}):
+    """Maps each host to a directory on its node-local storage. The
+    directory is listed by a task pinned to the location named after the
+    host, as started by add_host_local_workers, and each listed file
+    becomes a task at the location of its host. The directories are
+    listed right away, the parameters of the hosts are then generated one
+    host at a time, such that they can be passed to run or async_run."""
+    listings = self.run ( os.path.abspath (__file__)
+                        , 'list_node_local_files'
+                        , [ {'location' : host, 'parameters' : [str ({'path' : host_paths[host]})]}
+                            for host in host_paths
+                          ]
+                        )
+
+    for listing in listings:
+      if 'error' in listing:
+        raise RuntimeError ( "Listing '" + host_paths[listing['location']] + "' on host '"
+                           + listing['location'] + "' failed: " + listing['error']
+                           )
+
+    return ( { 'location' : listing['location']
+             , 'parameters' : [str (dict (config, filename = path)) for path in listing['result']]
+             }
+             for listing in listings
+           )
+
   def show_progress_and_store_results (self, handle, output_directory):
     n_tasks = self.get_total_number_of_tasks (handle)
-    result = self.results.pop (handle)
+    results = self.results.pop_many (handle, n_tasks)
     n_finished_tasks = 0
     progress_bar_len = 50
 
     print('', end='\n')
-    while result:
-      n_finished_tasks += 1
+    while results:
+      n_finished_tasks += len (results)
       finished_portion = n_finished_tasks/n_tasks
       progress_bar_signs = int (round (progress_bar_len * finished_portion))
       print ('\r[{0}] | {1:>3}% | {2:>6} of {3:>6}' .format
@@ -115,8 +206,8 @@ class dart_context (runtime):
             , flush=True
             )
 
-      self.results.store ([result], output_directory)
-      result = self.results.pop (handle)
+      self.results.store (results, output_directory)
+      results = self.results.pop_many (handle, n_tasks)
     print('\n')
 
   def get_progress_status (self, handle):
@@ -125,23 +216,36 @@ class dart_context (runtime):
     return n_completed_tasks, n_total_tasks
 
   class results:
-    def __init__(self, pop_result, collect_results, status_info_rep, job_name):
+    def __init__(self, pop_result, pop_results, collect_results, status_info_rep, job_name):
       self._pop_result = pop_result
+      self._pop_results = pop_results
       self._collect_results = collect_results
       self._status_info_rep = status_info_rep
       self._job_name = job_name
 
     def pop (self, job):
-      try:
-        result = self._pop_result (job)
-        if result and 'result' in result:
-          result['result'] = dart_context.unpack (result['result'])
+      popped = self._pop_result (job)
+      if popped is None:
+        return {}
+
+      result = task_result (*popped)
+      if 'result' in result:
+        result['result'] = dart_context.unpack (result['result'])
+
+      self.write_monitoring_info (job, result)
+
+      return result
+
+    def pop_many (self, job, max_n, timeout = None):
+      if timeout is None:
+        results = self.extract (self._pop_results (job, max_n))
+      else:
+        results = self.extract (self._pop_results (job, max_n, timeout))
 
+      for result in results:
         self.write_monitoring_info (job, result)
 
-        return result
-      except:
-        return {}
+      return results
 
     def clear_measurements (self):
       url = urlparse (self._status_info_rep)
@@ -198,7 +302,7 @@ class dart_context (runtime):
           sys.exit (1)
 
     def extract (self, results):
-      extracted = results
+      extracted = [task_result (*result) for result in results]
       for result in extracted:
         if 'result' in result:
           result['result'] = dart_context.unpack (result['result'])
@@ -206,7 +310,14 @@ class dart_context (runtime):
       return extracted
 
     def collect (self, job):
-      results = self.extract (self._collect_results (job))
+      try:
+        results = self.extract (self._collect_results (job))
+      except JobAborted as aborted:
+        aborted.results = self.extract (aborted.results)
+        for result in aborted.results:
+          self.write_monitoring_info (job, result)
+        raise
+
       for result in results:
         self.write_monitoring_info (job, result)
 
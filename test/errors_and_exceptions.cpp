@@ -13,7 +13,8 @@ BOOST_AUTO_TEST_CASE (module_not_found)
     , "."
     , "exceptions"
     , "module_not_found"
-    , ""
+    , we::type::bytearray()
+    , false
     , "worker"
     , "/var/tmp/log.txt"
     );
@@ -34,7 +35,8 @@ BOOST_AUTO_TEST_CASE (division_by_zero)
     , "."
     , "exceptions"
     , "division_by_zero"
-    , ""
+    , we::type::bytearray()
+    , false
     , "worker"
     , "/var/tmp/log.txt"
     );
@@ -55,7 +57,8 @@ BOOST_AUTO_TEST_CASE (file_not_found)
     , "."
     , "exceptions"
     , "file_not_found"
-    , ""
+    , we::type::bytearray()
+    , false
     , "worker"
     , "/var/tmp/log.txt"
     );
@@ -77,7 +80,8 @@ BOOST_AUTO_TEST_CASE (syntax_error)
     , "."
     , "parsing_errors"
     , "syntax_error"
-    , ""
+    , we::type::bytearray()
+    , false
     , "worker"
     , "/var/tmp/log.txt"
     );
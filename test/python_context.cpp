@@ -0,0 +1,244 @@
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <cpp/task_interface.hpp>
+
+#include <ctime>
+#include <fstream>
+#include <string>
+
+namespace
+{
+  boost::filesystem::path write_module
+    ( boost::filesystem::path const& directory
+    , std::string const& module
+    , std::string const& content
+    , std::time_t last_write_time
+    )
+  {
+    boost::filesystem::create_directories (directory);
+
+    boost::filesystem::path const file (directory / (module + ".py"));
+    std::ofstream (file.string()) << content;
+    boost::filesystem::last_write_time (file, last_write_time);
+
+    return file;
+  }
+
+  std::string run
+    ( boost::filesystem::path const& directory
+    , std::string const& module
+    , std::string const& method
+    , std::string const& parameters
+    , bool binary_parameters = false
+    )
+  {
+    boost::filesystem::path py_exe (PYTHON_EXECUTABLE);
+
+    auto const result = run_python_task
+      ( py_exe.parent_path().parent_path().string()
+      , PYTHON_LIBRARIES
+      , directory.string()
+      , module
+      , method
+      , we::type::bytearray (parameters.data(), parameters.size())
+      , binary_parameters
+      , "worker"
+      , "/var/tmp/log.txt"
+      );
+
+    BOOST_REQUIRE_MESSAGE (result.first.empty(), result.first);
+
+    return result.second.to_string();
+  }
+
+  std::pair<std::string, we::type::bytearray> run_with_timeout
+    ( boost::filesystem::path const& directory
+    , std::string const& module
+    , std::string const& method
+    , double timeout
+    )
+  {
+    boost::filesystem::path py_exe (PYTHON_EXECUTABLE);
+
+    return run_python_task
+      ( py_exe.parent_path().parent_path().string()
+      , PYTHON_LIBRARIES
+      , directory.string()
+      , module
+      , method
+      , we::type::bytearray()
+      , false
+      , "worker"
+      , "/var/tmp/log.txt"
+      , timeout
+      );
+  }
+}
+
+BOOST_AUTO_TEST_CASE (module_directory_is_added_to_sys_path_once)
+{
+  boost::filesystem::path const directory
+    (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path());
+
+  write_module ( directory
+               , "count_path"
+               , "import sys\n"
+                 "def count (path):\n"
+                 "  return str (sys.path.count (path)).encode()\n"
+               , std::time (nullptr)
+               );
+
+  for (int i (0); i < 3; ++i)
+  {
+    BOOST_REQUIRE_EQUAL
+      (run (directory, "count_path", "count", directory.string()), "1");
+  }
+
+  boost::filesystem::remove_all (directory);
+}
+
+BOOST_AUTO_TEST_CASE (module_is_reimported_when_changed_on_disk)
+{
+  boost::filesystem::path const directory
+    (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path());
+
+  std::time_t const now (std::time (nullptr));
+
+  write_module ( directory
+               , "versioned"
+               , "def version (params):\n"
+                 "  return b'1'\n"
+               , now - 10
+               );
+
+  BOOST_REQUIRE_EQUAL (run (directory, "versioned", "version", ""), "1");
+  BOOST_REQUIRE_EQUAL (run (directory, "versioned", "version", ""), "1");
+
+  write_module ( directory
+               , "versioned"
+               , "def version (params):\n"
+                 "  return b'2'\n"
+               , now
+               );
+
+  BOOST_REQUIRE_EQUAL (run (directory, "versioned", "version", ""), "2");
+
+  boost::filesystem::remove_all (directory);
+}
+
+BOOST_AUTO_TEST_CASE (module_changed_within_the_same_second_is_reimported)
+{
+  boost::filesystem::path const directory
+    (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path());
+
+  std::time_t const now (std::time (nullptr));
+
+  write_module ( directory
+               , "resized"
+               , "def version (params):\n"
+                 "  return b'1'\n"
+               , now
+               );
+
+  BOOST_REQUIRE_EQUAL (run (directory, "resized", "version", ""), "1");
+
+  write_module ( directory
+               , "resized"
+               , "def version (params):\n"
+                 "  return b'22'\n"
+               , now
+               );
+
+  BOOST_REQUIRE_EQUAL (run (directory, "resized", "version", ""), "22");
+
+  boost::filesystem::remove_all (directory);
+}
+
+BOOST_AUTO_TEST_CASE (modules_of_the_same_name_in_different_directories_are_distinct)
+{
+  boost::filesystem::path const root
+    (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path());
+
+  std::time_t const now (std::time (nullptr));
+
+  write_module ( root / "a"
+               , "same_name"
+               , "def which (params):\n"
+                 "  return b'a'\n"
+               , now
+               );
+  write_module ( root / "b"
+               , "same_name"
+               , "def which (params):\n"
+                 "  return b'b'\n"
+               , now
+               );
+
+  BOOST_REQUIRE_EQUAL (run (root / "a", "same_name", "which", ""), "a");
+  BOOST_REQUIRE_EQUAL (run (root / "b", "same_name", "which", ""), "b");
+  BOOST_REQUIRE_EQUAL (run (root / "a", "same_name", "which", ""), "a");
+
+  boost::filesystem::remove_all (root);
+}
+
+BOOST_AUTO_TEST_CASE (binary_parameters_are_passed_as_bytes)
+{
+  boost::filesystem::path const directory
+    (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path());
+
+  write_module ( directory
+               , "parameter_type"
+               , "def type_of (params):\n"
+                 "  if isinstance (params, bytes):\n"
+                 "    return b'bytes:' + params\n"
+                 "  return b'str:' + params.encode()\n"
+               , std::time (nullptr)
+               );
+
+  std::string const parameters ("a\0b", 3);
+
+  BOOST_REQUIRE_EQUAL
+    ( run (directory, "parameter_type", "type_of", parameters, true)
+    , std::string ("bytes:a\0b", 9)
+    );
+  BOOST_REQUIRE_EQUAL
+    ( run (directory, "parameter_type", "type_of", "x=1", false)
+    , "str:x=1"
+    );
+
+  boost::filesystem::remove_all (directory);
+}
+
+BOOST_AUTO_TEST_CASE (tasks_exceeding_the_timeout_are_aborted)
+{
+  boost::filesystem::path const directory
+    (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path());
+
+  write_module ( directory
+               , "hanging"
+               , "def hang (params):\n"
+                 "  while True:\n"
+                 "    pass\n"
+                 "def answer (params):\n"
+                 "  return b'42'\n"
+                 "def fail (params):\n"
+                 "  raise ValueError ('failed')\n"
+               , std::time (nullptr)
+               );
+
+  auto const timed_out (run_with_timeout (directory, "hanging", "hang", 0.5));
+
+  BOOST_REQUIRE_EQUAL
+    (timed_out.first.find (dart::task_timeout_error), 0);
+
+  auto const answer (run_with_timeout (directory, "hanging", "answer", 10));
+
+  BOOST_REQUIRE_MESSAGE (answer.first.empty(), answer.first);
+  BOOST_REQUIRE_EQUAL (answer.second.to_string(), "42");
+
+  auto const failed (run_with_timeout (directory, "hanging", "fail", 10));
+
+  BOOST_REQUIRE (failed.first.find ("ValueError") != std::string::npos);
+
+  boost::filesystem::remove_all (directory);
+}
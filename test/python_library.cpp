@@ -0,0 +1,38 @@
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <cpp/python_library.hpp>
+
+BOOST_AUTO_TEST_CASE (shared_library_is_found_in_python_home)
+{
+  boost::filesystem::path py_exe (PYTHON_EXECUTABLE);
+
+  auto const result = dart::locate_python_library
+    (py_exe.parent_path().parent_path().string(), "", "host");
+
+  BOOST_REQUIRE_MESSAGE (result.first.empty(), result.first);
+  BOOST_REQUIRE (boost::filesystem::exists (result.second));
+}
+
+BOOST_AUTO_TEST_CASE (given_shared_library_is_used)
+{
+  boost::filesystem::path py_exe (PYTHON_EXECUTABLE);
+
+  auto const result = dart::locate_python_library
+    (py_exe.parent_path().parent_path().string(), PYTHON_LIBRARIES, "host");
+
+  BOOST_REQUIRE_MESSAGE (result.first.empty(), result.first);
+  BOOST_REQUIRE_EQUAL (result.second, PYTHON_LIBRARIES);
+}
+
+BOOST_AUTO_TEST_CASE (missing_python_home_is_reported)
+{
+  boost::filesystem::path const python_home
+    (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path());
+
+  auto const result = dart::locate_python_library
+    (python_home.string(), "", "host");
+
+  BOOST_REQUIRE
+    (result.first.find ("does not exist on the host host") != std::string::npos);
+  BOOST_REQUIRE (result.second.empty());
+}
@@ -0,0 +1,67 @@
+#include <boost/test/unit_test.hpp>
+#include <boost/filesystem.hpp>
+#include <cpp/result_cache.hpp>
+
+#include <string>
+
+namespace
+{
+  we::type::bytearray bytes (std::string const& value)
+  {
+    return we::type::bytearray (value.data(), value.size());
+  }
+}
+
+BOOST_AUTO_TEST_CASE (stored_results_are_found_by_their_key)
+{
+  boost::filesystem::path const directory
+    (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path());
+
+  dart::result_cache const cache (directory.string(), "source", "method");
+
+  std::string const key (cache.key (bytes ("a=1"), false));
+
+  BOOST_REQUIRE (!cache.lookup (key));
+
+  cache.store (key, bytes (std::string ("result\0", 7)));
+
+  auto const result (cache.lookup (key));
+
+  BOOST_REQUIRE (result);
+  BOOST_REQUIRE_EQUAL (result->to_string(), std::string ("result\0", 7));
+
+  boost::filesystem::remove_all (directory);
+}
+
+BOOST_AUTO_TEST_CASE (keys_depend_on_module_method_and_parameters)
+{
+  dart::result_cache const cache ("/var/tmp", "source", "method");
+
+  std::string const key (cache.key (bytes ("a=1"), false));
+
+  BOOST_REQUIRE_EQUAL
+    ( key
+    , dart::result_cache ("/other", "source", "method").key (bytes ("a=1"), false)
+    );
+  BOOST_REQUIRE_NE
+    ( key
+    , dart::result_cache ("/var/tmp", "changed", "method").key (bytes ("a=1"), false)
+    );
+  BOOST_REQUIRE_NE
+    ( key
+    , dart::result_cache ("/var/tmp", "source", "other").key (bytes ("a=1"), false)
+    );
+  BOOST_REQUIRE_NE (key, cache.key (bytes ("a=2"), false));
+  BOOST_REQUIRE_NE (key, cache.key (bytes ("a=1"), true));
+}
+
+BOOST_AUTO_TEST_CASE (unreadable_module_disables_the_cache)
+{
+  boost::filesystem::path const directory
+    (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path());
+
+  BOOST_REQUIRE
+    ( !dart::result_cache::for_module
+        (directory.string(), directory.string(), "missing", "method")
+    );
+}